@@ -39,10 +39,6 @@
 #define _WIZCHIP_SPI_FDM_LEN1_  0x01
 #define _WIZCHIP_SPI_FDM_LEN2_  0x02
 #define _WIZCHIP_SPI_FDM_LEN4_  0x03
-//
-// If you want to use SPI FDM mode, Feel free contact to WIZnet. 
-// http://forum.wiznet.io
-//
 
 #if _WIZCHIP_ == 6100
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +46,92 @@
 
 #define _W6100_SPI_OP_          _WIZCHIP_SPI_VDM_OP_
 
+//
+// HOST interface dispatch.
+// If _WIZCHIP_PORT_STATIC_ is 1, the static inline functions of wizchip_port.h are called directly.
+//
+#if (_WIZCHIP_PORT_STATIC_ == 1)
+   #define WIZCHIP_CS_SELECT()                         wizchip_port_cs_select()
+   #define WIZCHIP_CS_DESELECT()                       wizchip_port_cs_deselect()
+   #define WIZCHIP_SPI_READ_BYTE()                     wizchip_port_spi_read_byte()
+   #define WIZCHIP_SPI_READ_BUF(pBuf, len)             wizchip_port_spi_read_buf(pBuf, len)
+   #define WIZCHIP_SPI_WRITE_BUF(pBuf, len)            wizchip_port_spi_write_buf(pBuf, len)
+   #define WIZCHIP_BUS_READ(AddrSel)                   wizchip_port_bus_read(AddrSel)
+   #define WIZCHIP_BUS_READ_BUF(AddrSel, pBuf, len, inc)  wizchip_port_bus_read_buf(AddrSel, pBuf, len, inc)
+   #define WIZCHIP_BUS_WRITE_BUF(AddrSel, pBuf, len, inc) wizchip_port_bus_write_buf(AddrSel, pBuf, len, inc)
+#else
+   #define WIZCHIP_CS_SELECT()                         WIZCHIP.CS._s_e_l_e_c_t_()
+   #define WIZCHIP_CS_DESELECT()                       WIZCHIP.CS._d_e_s_e_l_e_c_t_()
+   #define WIZCHIP_SPI_READ_BYTE()                     WIZCHIP.IF.SPI._read_byte()
+   #define WIZCHIP_SPI_READ_BUF(pBuf, len)             WIZCHIP.IF.SPI._read_byte_buf(pBuf, len)
+   #define WIZCHIP_SPI_WRITE_BUF(pBuf, len)            WIZCHIP.IF.SPI._write_byte_buf(pBuf, len)
+   #define WIZCHIP_BUS_READ(AddrSel)                   WIZCHIP.IF.BUS._read_data(AddrSel)
+   #define WIZCHIP_BUS_READ_BUF(AddrSel, pBuf, len, inc)  WIZCHIP.IF.BUS._read_data_buf(AddrSel, pBuf, len, inc)
+   #define WIZCHIP_BUS_WRITE_BUF(AddrSel, pBuf, len, inc) WIZCHIP.IF.BUS._write_data_buf(AddrSel, pBuf, len, inc)
+#endif
+
+static struct
+{
+   volatile uint8_t busy;                      ///< 1 while an asynchronous transfer owns WIZCHIP
+   uint8_t    sn;                              ///< SOCKETn of the pending transfer
+   datasize_t len;                             ///< Data length of the pending transfer
+   uint8_t    tptr[5];                         ///< SPI frame to update @ref _Sn_TX_WR_ or @ref _Sn_RX_RD_
+   void     (*done)(uint8_t sn, datasize_t len);
+}wiz_async;
+
+//
+// Enter the critical section after the pending asynchronous transfer is completed.
+// The critical section is not held while waiting, so the DMA completion interrupt can call wiz_async_done().
+//
+#if (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_)
+   #define WIZCHIP_CRITICAL_ENTER_SYNC()     \
+      do{                                    \
+         WIZCHIP_CRITICAL_ENTER();           \
+         while(wiz_async.busy)               \
+         {                                   \
+            WIZCHIP_CRITICAL_EXIT();         \
+            WIZCHIP_CRITICAL_ENTER();        \
+         }                                   \
+      }while(0)
+#else
+   #define WIZCHIP_CRITICAL_ENTER_SYNC()     WIZCHIP_CRITICAL_ENTER()
+#endif
+
+#if (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_)
+//
+// In SPI FDM, /SCS can be tied to low and each frame has fixed data length of 1, 2 or 4 bytes.
+// The data is split into frames as wide as possible and the offset is increased frame by frame.
+//
+static void wiz_spi_fdm_xfer(uint8_t* pAD, uint8_t rw, uint8_t* pBuf, datasize_t len)
+{
+   uint8_t  tAD[7];
+   uint16_t ofs = (((uint16_t)pAD[0]) << 8) + pAD[1];
+   uint8_t  flen, i;
+   while(len > 0)
+   {
+      tAD[0] = (uint8_t)(ofs >> 8);
+      tAD[1] = (uint8_t)ofs;
+      tAD[2] = pAD[2] | rw;
+      if(len >= 4)      { flen = 4; tAD[2] |= _WIZCHIP_SPI_FDM_LEN4_; }
+      else if(len >= 2) { flen = 2; tAD[2] |= _WIZCHIP_SPI_FDM_LEN2_; }
+      else              { flen = 1; tAD[2] |= _WIZCHIP_SPI_FDM_LEN1_; }
+      if(rw == _W6100_SPI_WRITE_)
+      {
+         for(i = 0; i < flen; i++) tAD[3+i] = pBuf[i];
+         WIZCHIP_SPI_WRITE_BUF(tAD, 3 + flen);
+      }
+      else
+      {
+         WIZCHIP_SPI_WRITE_BUF(tAD, 3);
+         WIZCHIP_SPI_READ_BUF(pBuf, flen);
+      }
+      ofs  += flen;
+      pBuf += flen;
+      len  -= flen;
+   }
+}
+#endif
+
 //////////////////////////////////////////////////
 void WIZCHIP_WRITE(uint32_t AddrSel, uint8_t wb )
 {
@@ -59,20 +141,24 @@ void WIZCHIP_WRITE(uint32_t AddrSel, uint8_t wb )
    tAD[2] = (uint8_t)(AddrSel & 0x000000ff);
    tAD[3] = wb;
 
-   WIZCHIP_CRITICAL_ENTER();
-   WIZCHIP.CS._s_e_l_e_c_t_();
+   WIZCHIP_CRITICAL_ENTER_SYNC();
+   WIZCHIP_CS_SELECT();
 
 #if( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_))
    tAD[2] |= (_W6100_SPI_WRITE_ | _W6100_SPI_OP_);
-   WIZCHIP.IF.SPI._write_byte_buf(tAD, 4);
+   WIZCHIP_SPI_WRITE_BUF(tAD, 4);
+
+#elif( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_))
+   tAD[2] |= (_W6100_SPI_WRITE_ | _WIZCHIP_SPI_FDM_LEN1_);
+   WIZCHIP_SPI_WRITE_BUF(tAD, 4);
 
 #elif ( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_INDIR_) )
-   WIZCHIP.IF.BUS._write_data_buf(IDM_AR0, tAD, 4, 1);
+   WIZCHIP_BUS_WRITE_BUF(IDM_AR0, tAD, 4, 1);
 #else
-   #error "Unknown _WIZCHIP_IO_MODE_ in W5100. !!!"
+   #error "Unknown _WIZCHIP_IO_MODE_ in W6100. !!!"
 #endif
 
-   WIZCHIP.CS._d_e_s_e_l_e_c_t_();
+   WIZCHIP_CS_DESELECT();
    WIZCHIP_CRITICAL_EXIT();
 }
 
@@ -84,21 +170,25 @@ uint8_t  WIZCHIP_READ(uint32_t AddrSel)
    tAD[1] = (uint8_t)((AddrSel & 0x0000FF00) >> 8);
    tAD[2] = (uint8_t)(AddrSel & 0x000000ff);
 
-   WIZCHIP_CRITICAL_ENTER();
-   WIZCHIP.CS._s_e_l_e_c_t_();
+   WIZCHIP_CRITICAL_ENTER_SYNC();
+   WIZCHIP_CS_SELECT();
 
 #if( (_WIZCHIP_IO_MODE_ ==  _WIZCHIP_IO_MODE_SPI_VDM_))
    tAD[2] |= (_W6100_SPI_READ_ | _W6100_SPI_OP_);
-   WIZCHIP.IF.SPI._write_byte_buf(tAD, 3);
-   ret = WIZCHIP.IF.SPI._read_byte();
+   WIZCHIP_SPI_WRITE_BUF(tAD, 3);
+   ret = WIZCHIP_SPI_READ_BYTE();
+#elif( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_))
+   tAD[2] |= (_W6100_SPI_READ_ | _WIZCHIP_SPI_FDM_LEN1_);
+   WIZCHIP_SPI_WRITE_BUF(tAD, 3);
+   ret = WIZCHIP_SPI_READ_BYTE();
 #elif ( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_INDIR_) )
-   WIZCHIP.IF.BUS._write_data_buf(IDM_AR0,tAD,3,1);
-   ret = WIZCHIP.IF.BUS._read_data(IDM_DR);
+   WIZCHIP_BUS_WRITE_BUF(IDM_AR0,tAD,3,1);
+   ret = WIZCHIP_BUS_READ(IDM_DR);
 #else
    #error "Unknown _WIZCHIP_IO_MODE_ in W6100. !!!"   
 #endif
 
-   WIZCHIP.CS._d_e_s_e_l_e_c_t_();
+   WIZCHIP_CS_DESELECT();
    WIZCHIP_CRITICAL_EXIT();
    return ret;
 }
@@ -111,23 +201,26 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len)
    tAD[2] = (uint8_t)(AddrSel & 0x000000ff);
 
 
-   WIZCHIP_CRITICAL_ENTER();
-   WIZCHIP.CS._s_e_l_e_c_t_();
+   WIZCHIP_CRITICAL_ENTER_SYNC();
+   WIZCHIP_CS_SELECT();
 
 #if((_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_))
    tAD[2] |= (_W6100_SPI_WRITE_ | _W6100_SPI_OP_);
 
-   WIZCHIP.IF.SPI._write_byte_buf(tAD, 3);
-   WIZCHIP.IF.SPI._write_byte_buf(pBuf, len);
+   WIZCHIP_SPI_WRITE_BUF(tAD, 3);
+   WIZCHIP_SPI_WRITE_BUF(pBuf, len);
+
+#elif( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_))
+   wiz_spi_fdm_xfer(tAD, _W6100_SPI_WRITE_, pBuf, len);
 
 #elif ( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_INDIR_) )
-   WIZCHIP.IF.BUS._write_data_buf(IDM_AR0,tAD, 3, 1);
-   WIZCHIP.IF.BUS._write_data_buf(IDM_DR,pBuf,len, 0);
+   WIZCHIP_BUS_WRITE_BUF(IDM_AR0,tAD, 3, 1);
+   WIZCHIP_BUS_WRITE_BUF(IDM_DR,pBuf,len, 0);
 #else
    #error "Unknown _WIZCHIP_IO_MODE_ in W6100. !!!!"
 #endif
 
-   WIZCHIP.CS._d_e_s_e_l_e_c_t_();
+   WIZCHIP_CS_DESELECT();
    WIZCHIP_CRITICAL_EXIT();
 }
 
@@ -138,31 +231,149 @@ void WIZCHIP_READ_BUF (uint32_t AddrSel, uint8_t* pBuf, datasize_t len)
    tAD[1] = (uint8_t)((AddrSel & 0x0000FF00) >> 8);
    tAD[2] = (uint8_t)(AddrSel & 0x000000ff);
 
-   WIZCHIP_CRITICAL_ENTER();
-   WIZCHIP.CS._s_e_l_e_c_t_();
+   WIZCHIP_CRITICAL_ENTER_SYNC();
+   WIZCHIP_CS_SELECT();
 
 #if((_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_))
    tAD[2] |= (_W6100_SPI_READ_ | _W6100_SPI_OP_);
-   WIZCHIP.IF.SPI._write_byte_buf(tAD,3);
-   WIZCHIP.IF.SPI._read_byte_buf(pBuf, len);
+   WIZCHIP_SPI_WRITE_BUF(tAD,3);
+   WIZCHIP_SPI_READ_BUF(pBuf, len);
+#elif( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_))
+   wiz_spi_fdm_xfer(tAD, _W6100_SPI_READ_, pBuf, len);
 #elif ( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_INDIR_) )
-   WIZCHIP.IF.BUS._write_data_buf(IDM_AR0,tAD,3,1);
-   WIZCHIP.IF.BUS._read_data_buf(IDM_DR,pBuf,len,0);
+   WIZCHIP_BUS_WRITE_BUF(IDM_AR0,tAD,3,1);
+   WIZCHIP_BUS_READ_BUF(IDM_DR,pBuf,len,0);
 #else
    #error "Unknown _WIZCHIP_IO_MODE_ in W6100. !!!!"
 #endif
-   WIZCHIP.CS._d_e_s_e_l_e_c_t_();
+   WIZCHIP_CS_DESELECT();
    WIZCHIP_CRITICAL_EXIT();
 }
 
+void WIZCHIP_XFER_V(wiz_XferDesc* xfer, uint8_t cnt)
+{
+   uint8_t i;
+   for(i = 0; i < cnt; i++)
+   {
+      xfer[i].hdr[0] = (uint8_t)((xfer[i].AddrSel & 0x00FF0000) >> 16);
+      xfer[i].hdr[1] = (uint8_t)((xfer[i].AddrSel & 0x0000FF00) >> 8);
+      xfer[i].hdr[2] = (uint8_t)(xfer[i].AddrSel & 0x000000ff);
+#if( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_) )
+      xfer[i].hdr[2] |= (((xfer[i].rw == WIZCHIP_XFER_WRITE) ? _W6100_SPI_WRITE_ : _W6100_SPI_READ_) | _W6100_SPI_OP_);
+#endif
+   }
+
+   WIZCHIP_CRITICAL_ENTER_SYNC();
+#if( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_FDM_) )
+   for(i = 0; i < cnt; i++)
+   {
+      WIZCHIP_CS_SELECT();
+      wiz_spi_fdm_xfer(xfer[i].hdr, (xfer[i].rw == WIZCHIP_XFER_WRITE) ? _W6100_SPI_WRITE_ : _W6100_SPI_READ_, xfer[i].pBuf, xfer[i].len);
+      WIZCHIP_CS_DESELECT();
+   }
+#else
+   if(WIZCHIP._xfer_v)
+   {
+      WIZCHIP._xfer_v(xfer, cnt);
+   }
+   else
+   {
+      for(i = 0; i < cnt; i++)
+      {
+         WIZCHIP_CS_SELECT();
+#if((_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_))
+         WIZCHIP_SPI_WRITE_BUF(xfer[i].hdr, 3);
+         if(xfer[i].rw == WIZCHIP_XFER_WRITE) WIZCHIP_SPI_WRITE_BUF(xfer[i].pBuf, xfer[i].len);
+         else                                 WIZCHIP_SPI_READ_BUF(xfer[i].pBuf, xfer[i].len);
+#elif ( (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_INDIR_) )
+         WIZCHIP_BUS_WRITE_BUF(IDM_AR0, xfer[i].hdr, 3, 1);
+         if(xfer[i].rw == WIZCHIP_XFER_WRITE) WIZCHIP_BUS_WRITE_BUF(IDM_DR, xfer[i].pBuf, xfer[i].len, 0);
+         else                                 WIZCHIP_BUS_READ_BUF(IDM_DR, xfer[i].pBuf, xfer[i].len, 0);
+#else
+   #error "Unknown _WIZCHIP_IO_MODE_ in W6100. !!!!"
+#endif
+         WIZCHIP_CS_DESELECT();
+      }
+   }
+#endif
+   WIZCHIP_CRITICAL_EXIT();
+}
+
+uint16_t WIZCHIP_READ16(uint32_t AddrSel)
+{
+   uint8_t tmp[2];
+   WIZCHIP_READ_BUF(AddrSel, tmp, 2);
+   return (((uint16_t)tmp[0]) << 8) + tmp[1];
+}
+
+void WIZCHIP_WRITE16(uint32_t AddrSel, uint16_t wb)
+{
+   uint8_t tmp[2];
+   tmp[0] = (uint8_t)(wb >> 8);
+   tmp[1] = (uint8_t)wb;
+   WIZCHIP_WRITE_BUF(AddrSel, tmp, 2);
+}
+
+uint32_t WIZCHIP_READ32(uint32_t AddrSel)
+{
+   uint8_t tmp[4];
+   WIZCHIP_READ_BUF(AddrSel, tmp, 4);
+   return (((uint32_t)tmp[0]) << 24) + (((uint32_t)tmp[1]) << 16) + (((uint32_t)tmp[2]) << 8) + tmp[3];
+}
+
+void WIZCHIP_WRITE32(uint32_t AddrSel, uint32_t wb)
+{
+   uint8_t tmp[4];
+   tmp[0] = (uint8_t)(wb >> 24);
+   tmp[1] = (uint8_t)(wb >> 16);
+   tmp[2] = (uint8_t)(wb >> 8);
+   tmp[3] = (uint8_t)wb;
+   WIZCHIP_WRITE_BUF(AddrSel, tmp, 4);
+}
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+_WIZCHIP_SHADOW_ WIZCHIP_SHADOW;
+
+void wiz_shadow_read(uint32_t AddrSel, uint8_t* pShadow, uint8_t* pBuf, datasize_t len, uint8_t* valid, uint8_t flag)
+{
+   datasize_t i;
+   if(!(*valid & flag))
+   {
+      WIZCHIP_READ_BUF(AddrSel, pShadow, len);
+      *valid |= flag;
+   }
+   if(pBuf)
+      for(i = 0; i < len; i++) pBuf[i] = pShadow[i];
+}
+
+void wiz_shadow_write(uint32_t AddrSel, uint8_t* pShadow, uint8_t* pBuf, datasize_t len, uint8_t* valid, uint8_t flag)
+{
+   datasize_t i;
+   if(pBuf != pShadow)
+      for(i = 0; i < len; i++) pShadow[i] = pBuf[i];
+   WIZCHIP_WRITE_BUF(AddrSel, pShadow, len);
+   *valid |= flag;
+}
+
+void wiz_shadow_clear(void)
+{
+   uint8_t i;
+   WIZCHIP_SHADOW.valid = 0;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++) WIZCHIP_SHADOW.sock[i].valid = 0;
+}
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+
 datasize_t getSn_TX_FSR(uint8_t sn)
 {
    datasize_t prev_val=-1,val=0;
    do
    {
       prev_val = val;
-      val = WIZCHIP_READ(_Sn_TX_FSR_(sn));
-      val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_TX_FSR_(sn),1));
+      val = WIZCHIP_READ16(_Sn_TX_FSR_(sn));
    }while (val != prev_val);
    return val;
 }
@@ -173,33 +384,50 @@ datasize_t getSn_RX_RSR(uint8_t sn)
    do
    {
       prev_val = val;
-      val = WIZCHIP_READ(_Sn_RX_RSR_(sn));
-      val = (val << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_RX_RSR_(sn),1));
+      val = WIZCHIP_READ16(_Sn_RX_RSR_(sn));
    }while (val != prev_val);
    return val;
 }
 
 void wiz_send_data(uint8_t sn, uint8_t *wizdata, datasize_t len)
 {
-   datasize_t ptr = 0;
-   uint32_t addrsel = 0;
+   uint16_t ptr = 0;
+   uint8_t  tptr[2];
+   wiz_XferDesc xfer[2];
    ptr = getSn_TX_WR(sn);
-   addrsel = ((uint32_t)ptr << 8) + WIZCHIP_TXBUF_BLOCK(sn);
-   WIZCHIP_WRITE_BUF(addrsel,wizdata, len);
+   xfer[0].AddrSel = ((uint32_t)ptr << 8) + WIZCHIP_TXBUF_BLOCK(sn);
+   xfer[0].pBuf    = wizdata;
+   xfer[0].len     = len;
+   xfer[0].rw      = WIZCHIP_XFER_WRITE;
    ptr += len;
-   setSn_TX_WR(sn,ptr);
+   tptr[0] = (uint8_t)(ptr >> 8);
+   tptr[1] = (uint8_t)ptr;
+   xfer[1].AddrSel = _Sn_TX_WR_(sn);
+   xfer[1].pBuf    = tptr;
+   xfer[1].len     = 2;
+   xfer[1].rw      = WIZCHIP_XFER_WRITE;
+   WIZCHIP_XFER_V(xfer, 2);
 }
 
 void wiz_recv_data(uint8_t sn, uint8_t *wizdata, datasize_t len)
 {
-   datasize_t ptr = 0;
-   uint32_t addrsel = 0;
+   uint16_t ptr = 0;
+   uint8_t  tptr[2];
+   wiz_XferDesc xfer[2];
    if(len == 0) return;
    ptr = getSn_RX_RD(sn);
-   addrsel = ((uint32_t)ptr << 8) + WIZCHIP_RXBUF_BLOCK(sn);
-   WIZCHIP_READ_BUF(addrsel, wizdata, len);
+   xfer[0].AddrSel = ((uint32_t)ptr << 8) + WIZCHIP_RXBUF_BLOCK(sn);
+   xfer[0].pBuf    = wizdata;
+   xfer[0].len     = len;
+   xfer[0].rw      = WIZCHIP_XFER_READ;
    ptr += len;
-   setSn_RX_RD(sn,ptr);
+   tptr[0] = (uint8_t)(ptr >> 8);
+   tptr[1] = (uint8_t)ptr;
+   xfer[1].AddrSel = _Sn_RX_RD_(sn);
+   xfer[1].pBuf    = tptr;
+   xfer[1].len     = 2;
+   xfer[1].rw      = WIZCHIP_XFER_WRITE;
+   WIZCHIP_XFER_V(xfer, 2);
 }
 
 void wiz_recv_ignore(uint8_t sn, datasize_t len)
@@ -207,6 +435,101 @@ void wiz_recv_ignore(uint8_t sn, datasize_t len)
    setSn_RX_RD(sn,getSn_RX_RD(sn)+len);
 }
 
+static int8_t wiz_async_start(uint8_t sn, uint32_t AddrSel, uint32_t PtrSel, uint16_t ptr, uint8_t* wizdata, datasize_t len, uint8_t rw, void (*done)(uint8_t sn, datasize_t len))
+{
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_)
+/// @endcond
+   uint8_t tAD[3];
+   void (*xfer)(uint8_t* pBuf, datasize_t len);
+   xfer = (rw == WIZCHIP_XFER_WRITE) ? WIZCHIP.ASYNC._write_byte_buf : WIZCHIP.ASYNC._read_byte_buf;
+   if(xfer)
+   {
+      tAD[0] = (uint8_t)((AddrSel & 0x00FF0000) >> 16);
+      tAD[1] = (uint8_t)((AddrSel & 0x0000FF00) >> 8);
+      tAD[2] = (uint8_t)(AddrSel & 0x000000ff);
+      tAD[2] |= (((rw == WIZCHIP_XFER_WRITE) ? _W6100_SPI_WRITE_ : _W6100_SPI_READ_) | _W6100_SPI_OP_);
+      WIZCHIP_CRITICAL_ENTER();
+      if(wiz_async.busy)
+      {
+         WIZCHIP_CRITICAL_EXIT();
+         return -1;             // Another transfer is in flight.
+      }
+      wiz_async.tptr[0] = (uint8_t)((PtrSel & 0x00FF0000) >> 16);
+      wiz_async.tptr[1] = (uint8_t)((PtrSel & 0x0000FF00) >> 8);
+      wiz_async.tptr[2] = (uint8_t)(PtrSel & 0x000000ff) | _W6100_SPI_WRITE_ | _W6100_SPI_OP_;
+      wiz_async.tptr[3] = (uint8_t)(ptr >> 8);
+      wiz_async.tptr[4] = (uint8_t)ptr;
+      wiz_async.sn   = sn;
+      wiz_async.len  = len;
+      wiz_async.done = done;
+      wiz_async.busy = 1;       // The other accesses wait until wiz_async_done().
+      WIZCHIP_CS_SELECT();
+      WIZCHIP_SPI_WRITE_BUF(tAD, 3);
+      xfer(wizdata, len);       // wiz_async_done() is called on the completion
+      WIZCHIP_CRITICAL_EXIT();
+      return 0;
+   }
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
+   (void)AddrSel;
+   (void)PtrSel;
+   (void)ptr;
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+   if(rw == WIZCHIP_XFER_WRITE) wiz_send_data(sn, wizdata, len);
+   else                         wiz_recv_data(sn, wizdata, len);
+   if(done) done(sn, len);
+   return 0;
+}
+
+int8_t wiz_send_data_async(uint8_t sn, uint8_t *wizdata, datasize_t len, void (*done)(uint8_t sn, datasize_t len))
+{
+   uint16_t ptr = 0;
+   if(wiz_async.busy) return -1;
+   ptr = getSn_TX_WR(sn);
+   return wiz_async_start(sn, ((uint32_t)ptr << 8) + WIZCHIP_TXBUF_BLOCK(sn), _Sn_TX_WR_(sn), ptr + len,
+                          wizdata, len, WIZCHIP_XFER_WRITE, done);
+}
+
+int8_t wiz_recv_data_async(uint8_t sn, uint8_t *wizdata, datasize_t len, void (*done)(uint8_t sn, datasize_t len))
+{
+   uint16_t ptr = 0;
+   if(wiz_async.busy) return -1;
+   if(len == 0)
+   {
+      if(done) done(sn, len);
+      return 0;
+   }
+   ptr = getSn_RX_RD(sn);
+   return wiz_async_start(sn, ((uint32_t)ptr << 8) + WIZCHIP_RXBUF_BLOCK(sn), _Sn_RX_RD_(sn), ptr + len,
+                          wizdata, len, WIZCHIP_XFER_READ, done);
+}
+
+void wiz_async_done(void)
+{
+   if(!wiz_async.busy) return;
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_)
+/// @endcond
+   WIZCHIP_CS_DESELECT();
+   WIZCHIP_CS_SELECT();
+   WIZCHIP_SPI_WRITE_BUF(wiz_async.tptr, 5);
+   WIZCHIP_CS_DESELECT();
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+   wiz_async.busy = 0;
+   if(wiz_async.done) wiz_async.done(wiz_async.sn, wiz_async.len);
+}
+
+uint8_t wiz_async_busy(void)
+{
+   return wiz_async.busy;
+}
+
 
 /// @cond DOXY_APPLY_CODE
 #if (_PHY_IO_MODE_ == _PHY_IO_MODE_MII_)
@@ -3345,7 +3345,15 @@ extern "C" {
  * @sa WIZCHIP_READ(), WIZCHIP_WRITE(), WIZCHIP_READ_BUF(), WIZCHIP_WRITE_BUF()
  * @sa WIZCHIP_CRITICAL_EXIT(), reg_wizchip_cris_cbfunc()
  */
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_PORT_STATIC_ == 1)
+   #define WIZCHIP_CRITICAL_ENTER()    wizchip_port_cris_enter()
+#else
+/// @endcond
 #define WIZCHIP_CRITICAL_ENTER()       WIZCHIP.CRIS._e_n_t_e_r_()
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 
 /**
@@ -3360,7 +3368,15 @@ extern "C" {
  * @sa WIZCHIP_READ(), WIZCHIP_WRITE(), WIZCHIP_READ_BUF(), WIZCHIP_WRITE_BUF()
  * @sa WIZCHIP_CRITICAL_EXIT(), reg_wizchip_cris_cbfunc()
  */
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_PORT_STATIC_ == 1)
+   #define WIZCHIP_CRITICAL_EXIT()     wizchip_port_cris_exit()
+#else
+/// @endcond
 #define WIZCHIP_CRITICAL_EXIT()        WIZCHIP.CRIS._e_x_i_t_()
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 
 
@@ -3410,6 +3426,157 @@ void WIZCHIP_READ_BUF (uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
  */
 void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It runs a list of register and buffer accesses in one critical section.
+ * @details It fills <i>hdr</i> of each @ref wiz_XferDesc, and then runs the accesses back-to-back\n
+ *          between @ref WIZCHIP_CRITICAL_ENTER() and @ref WIZCHIP_CRITICAL_EXIT().\n
+ *          If a callback function is registered by @ref reg_wizchip_xfer_cbfunc(), the whole list is passed to it at once.\n
+ *          Otherwise, each access is run with the callback functions of @ref _WIZCHIP_T_ like as @ref WIZCHIP_READ_BUF() and @ref WIZCHIP_WRITE_BUF().
+ * @param xfer Transfer descriptor list
+ * @param cnt The count of <i>xfer</i>
+ * @return void
+ * @sa WIZCHIP_READ_BUF(), WIZCHIP_WRITE_BUF(), reg_wizchip_xfer_cbfunc()
+ */
+void WIZCHIP_XFER_V(wiz_XferDesc* xfer, uint8_t cnt);
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It reads 2 bytes value from a 16bit register in one burst access.
+ * @param AddrSel Register address. The high byte is at <i>AddrSel</i>.
+ * @return The value of register
+ * @sa WIZCHIP_WRITE16(), WIZCHIP_READ32(), WIZCHIP_READ_BUF()
+ */
+uint16_t WIZCHIP_READ16(uint32_t AddrSel);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It writes 2 bytes value to a 16bit register in one burst access.
+ * @param AddrSel Register address. The high byte is at <i>AddrSel</i>.
+ * @param wb Write data
+ * @return void
+ * @sa WIZCHIP_READ16(), WIZCHIP_WRITE32(), WIZCHIP_WRITE_BUF()
+ */
+void WIZCHIP_WRITE16(uint32_t AddrSel, uint16_t wb);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It reads 4 bytes value from a 32bit register in one burst access.
+ * @param AddrSel Register address. The highest byte is at <i>AddrSel</i>.
+ * @return The value of register
+ * @sa WIZCHIP_WRITE32(), WIZCHIP_READ16(), WIZCHIP_READ_BUF()
+ */
+uint32_t WIZCHIP_READ32(uint32_t AddrSel);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It writes 4 bytes value to a 32bit register in one burst access.
+ * @param AddrSel Register address. The highest byte is at <i>AddrSel</i>.
+ * @param wb Write data
+ * @return void
+ * @sa WIZCHIP_READ32(), WIZCHIP_WRITE16(), WIZCHIP_WRITE_BUF()
+ */
+void WIZCHIP_WRITE32(uint32_t AddrSel, uint32_t wb);
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+
+#define SHADOW_SHAR          (1<<0)   ///< @ref _SHAR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_SIPR          (1<<1)   ///< @ref _SIPR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_LLAR          (1<<2)   ///< @ref _LLAR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_GUAR          (1<<3)   ///< @ref _GUAR_ is valid in @ref WIZCHIP_SHADOW.
+
+#define SHADOW_Sn_MR         (1<<0)   ///< @ref _Sn_MR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_MR2        (1<<1)   ///< @ref _Sn_MR2_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_TX_BSR     (1<<2)   ///< @ref _Sn_TX_BSR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_RX_BSR     (1<<3)   ///< @ref _Sn_RX_BSR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_PORTR      (1<<4)   ///< @ref _Sn_PORTR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_DIPR       (1<<5)   ///< @ref _Sn_DIPR_ is valid in @ref WIZCHIP_SHADOW.
+#define SHADOW_Sn_DPORTR     (1<<6)   ///< @ref _Sn_DPORTR_ is valid in @ref WIZCHIP_SHADOW.
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It checks whether @ref _Sn_DIPR_ and @ref _Sn_DPORTR_ of SOCKETn are read from @ref WIZCHIP_SHADOW.
+ * @details They are written only by HOST in UDP mode. In TCP mode, @ref _WIZCHIP_ writes them with the connected peer,
+ *          so they are always read from @ref _WIZCHIP_.
+ */
+#define SHADOW_Sn_DST(sn)    ((getSn_MR(sn) & 0x03) == Sn_MR_UDP)
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief Shadow registers in HOST memory
+ * @details @ref _WIZCHIP_SHADOW_ keeps the registers which only HOST writes.\n
+ *          A shadow register is loaded from @ref _WIZCHIP_ at the first access, and updated by its set function.\n
+ *          The common network registers are reloaded after their set function, because they are ignored by @ref _WIZCHIP_ when @ref SYSR_NETL is set.
+ * @note It is valid only when @ref _WIZCHIP_SHADOW_REG_ is 1.
+ * @sa wiz_shadow_read(), wiz_shadow_clear()
+ */
+typedef struct __WIZCHIP_SHADOW__
+{
+   uint8_t  valid;         ///< Valid flags such as @ref SHADOW_SHAR
+   uint8_t  SHAR[6];       ///< @ref _SHAR_
+   uint8_t  SIPR[4];       ///< @ref _SIPR_
+   uint8_t  LLAR[16];      ///< @ref _LLAR_
+   uint8_t  GUAR[16];      ///< @ref _GUAR_
+
+   ///< SOCKETn shadow registers
+   struct _SOCK
+   {
+      uint8_t  valid;      ///< Valid flags such as @ref SHADOW_Sn_MR
+      uint8_t  MR;         ///< @ref _Sn_MR_
+      uint8_t  MR2;        ///< @ref _Sn_MR2_
+      uint8_t  TX_BSR;     ///< @ref _Sn_TX_BSR_
+      uint8_t  RX_BSR;     ///< @ref _Sn_RX_BSR_
+      uint8_t  PORTR[2];   ///< @ref _Sn_PORTR_
+      uint8_t  DIPR[4];    ///< @ref _Sn_DIPR_
+      uint8_t  DPORTR[2];  ///< @ref _Sn_DPORTR_
+   }sock[_WIZCHIP_SOCK_NUM_];
+}_WIZCHIP_SHADOW_;
+
+extern _WIZCHIP_SHADOW_ WIZCHIP_SHADOW;   ///< @ref WIZCHIP_SHADOW is instance of @ref _WIZCHIP_SHADOW_.
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It reads a shadow register.
+ * @details If the shadow register is not valid, It loads the shadow register from @ref _WIZCHIP_ first.
+ * @param AddrSel Register address
+ * @param pShadow Pointer of the shadow register in @ref WIZCHIP_SHADOW
+ * @param pBuf Pointer buffer to copy the shadow register. It can be null.
+ * @param len Register length
+ * @param valid Pointer of the valid flags in @ref WIZCHIP_SHADOW
+ * @param flag Valid flag of the shadow register such as @ref SHADOW_Sn_MR
+ * @return void
+ * @sa wiz_shadow_write(), wiz_shadow_clear()
+ */
+void wiz_shadow_read(uint32_t AddrSel, uint8_t* pShadow, uint8_t* pBuf, datasize_t len, uint8_t* valid, uint8_t flag);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It writes a register and its shadow register.
+ * @param AddrSel Register address
+ * @param pShadow Pointer of the shadow register in @ref WIZCHIP_SHADOW
+ * @param pBuf Pointer buffer to write data. It can be same as <i>pShadow</i>.
+ * @param len Register length
+ * @param valid Pointer of the valid flags in @ref WIZCHIP_SHADOW
+ * @param flag Valid flag of the shadow register such as @ref SHADOW_Sn_MR
+ * @return void
+ * @sa wiz_shadow_read()
+ */
+void wiz_shadow_write(uint32_t AddrSel, uint8_t* pShadow, uint8_t* pBuf, datasize_t len, uint8_t* valid, uint8_t flag);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It invalidates all shadow registers.
+ * @details It is called by @ref setSYCR0(). You should call it after the hardware reset of @ref _WIZCHIP_.
+ * @return void
+ * @sa wiz_shadow_read()
+ */
+void wiz_shadow_clear(void);
+
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+
 
 
 /////////////////////////////////
@@ -3420,10 +3587,10 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
  * @{
  */
 #define getCIDR() \
-        ((((uint16_t)WIZCHIP_READ(_CIDR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_CIDR_,1)))
+        WIZCHIP_READ16(_CIDR_)
 
 #define getVER() \
-        ((((uint16_t)WIZCHIP_READ(_VER_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_VER_,1)))
+        WIZCHIP_READ16(_VER_)
 
 #define getSYSR() \
         WIZCHIP_READ(_SYSR_)
@@ -3431,8 +3598,22 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define getSYCR0() \
         WIZCHIP_READ(_SYCR0_)
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSYCR0(sycr0) \
+        do{                                    \
+            WIZCHIP_WRITE(_SYCR0_, (sycr0));   \
+            wiz_shadow_clear();                \
+        }while(0)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSYCR0(sycr0) \
         WIZCHIP_WRITE(_SYCR0_, (sycr0))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define getSYCR1() \
         WIZCHIP_READ(_SYCR1_)
@@ -3441,7 +3622,7 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_WRITE(_SYCR1_, (sycr1))
 
 #define getTCNTR() \
-        ((((uint16_t)WIZCHIP_READ(_TCNTR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_TCNTR_,1)))
+        WIZCHIP_READ16(_TCNTR_)
 
 #define setTCNTRCLR(tcntrclr) \
         WIZCHIP_WRITE(_TCNTRCLR_,(tcntrclr))
@@ -3575,28 +3756,39 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_READ_BUF(_PHAR_,(phar),6)
 
 #define setPSIDR(psidr) \
-        do{                                                                \
-            WIZCHIP_WRITE(_PSIDR_,(uint8_t)((psidr) >> 8));                \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_PSIDR_,1),(uint8_t)(psidr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_PSIDR_,(psidr))
 
 #define getPSIDR() \
-        ((((uint16_t)WIZCHIP_READ(_PSIDR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PSIDR_,1)))
+        WIZCHIP_READ16(_PSIDR_)
 
 #define setPMRUR(pmrur) \
-        do{                                                                \
-            WIZCHIP_WRITE(_PMRUR_,(uint8_t)((pmrur) >> 8));                \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_PMRUR_,1),(uint8_t)(pmrur)); \
-        }while(0);
+        WIZCHIP_WRITE16(_PMRUR_,(pmrur))
 
 #define getPMRUR() \
-        ((((uint16_t)WIZCHIP_READ(_PMRUR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PMRUR_,1)))
+        WIZCHIP_READ16(_PMRUR_)
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSHAR(shar) \
+        do{                                       \
+            WIZCHIP_WRITE_BUF(_SHAR_,(shar),6);   \
+            WIZCHIP_SHADOW.valid &= ~SHADOW_SHAR; \
+        }while(0)
+
+#define getSHAR(shar) \
+        wiz_shadow_read(_SHAR_, WIZCHIP_SHADOW.SHAR, (shar), 6, &WIZCHIP_SHADOW.valid, SHADOW_SHAR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSHAR(shar) \
         WIZCHIP_WRITE_BUF(_SHAR_,(shar),6)
 
 #define getSHAR(shar) \
         WIZCHIP_READ_BUF(_SHAR_,(shar),6)
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setGAR(gar) \
         WIZCHIP_WRITE_BUF(_GAR_,(gar),4)
@@ -3616,23 +3808,74 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define setSUB4R(sub4r)          setSUBR(sub4r)
 #define getSUB4R(sub4r)          getSUBR(sub4r)
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSIPR(sipr) \
+        do{                                       \
+            WIZCHIP_WRITE_BUF(_SIPR_,(sipr),4);   \
+            WIZCHIP_SHADOW.valid &= ~SHADOW_SIPR; \
+        }while(0)
+
+#define getSIPR(sipr) \
+        wiz_shadow_read(_SIPR_, WIZCHIP_SHADOW.SIPR, (sipr), 4, &WIZCHIP_SHADOW.valid, SHADOW_SIPR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSIPR(sipr) \
         WIZCHIP_WRITE_BUF(_SIPR_,(sipr),4)
 
 #define getSIPR(sipr) \
         WIZCHIP_READ_BUF(_SIPR_,(sipr),4)
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setLLAR(llar) \
+        do{                                       \
+            WIZCHIP_WRITE_BUF(_LLAR_,(llar),16);  \
+            WIZCHIP_SHADOW.valid &= ~SHADOW_LLAR; \
+        }while(0)
+
+#define getLLAR(llar) \
+        wiz_shadow_read(_LLAR_, WIZCHIP_SHADOW.LLAR, (llar), 16, &WIZCHIP_SHADOW.valid, SHADOW_LLAR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setLLAR(llar) \
         WIZCHIP_WRITE_BUF(_LLAR_,(llar),16)
 
 #define getLLAR(llar) \
         WIZCHIP_READ_BUF(_LLAR_,(llar),16)
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setGUAR(guar) \
+        do{                                       \
+            WIZCHIP_WRITE_BUF(_GUAR_,(guar),16);  \
+            WIZCHIP_SHADOW.valid &= ~SHADOW_GUAR; \
+        }while(0)
+
+#define getGUAR(guar) \
+        wiz_shadow_read(_GUAR_, WIZCHIP_SHADOW.GUAR, (guar), 16, &WIZCHIP_SHADOW.valid, SHADOW_GUAR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setGUAR(guar) \
         WIZCHIP_WRITE_BUF(_GUAR_,(guar),16)
 
 #define getGUAR(guar) \
         WIZCHIP_READ_BUF(_GUAR_,(guar),16)
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setSUB6R(sub6r) \
         WIZCHIP_WRITE_BUF(_SUB6R_,(sub6r),16)
@@ -3664,22 +3907,16 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_READ_BUF(_SLDHAR_,(sldhar),6)
 
 #define setPINGIDR(pingidr) \
-        do{                                                                    \
-            WIZCHIP_WRITE(_PINGIDR_,(uint8_t)((pingidr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_PINGIDR_,1),(uint8_t)(pingidr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_PINGIDR_,(pingidr))
 
 #define getPINGIDR() \
-        (((int16_t)(WIZCHIP_READ(_PINGIDR_) << 8)) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PINGIDR_,1)))
+        WIZCHIP_READ16(_PINGIDR_)
 
 #define setPINGSEQR(pingseqr) \
-        do{                                                                      \
-            WIZCHIP_WRITE(_PINGSEQR_,(uint8_t)((pingseqr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_PINGSEQR_,1),(uint8_t)(pingseqr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_PINGSEQR_,(pingseqr))
 
 #define getPINGSEQR() \
-        (((int16_t)(WIZCHIP_READ(_PINGSEQR_) << 8)) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PINGSEQR_,1)))
+        WIZCHIP_READ16(_PINGSEQR_)
 
 #define getUIPR(uipr) \
         WIZCHIP_READ_BUF(_UIPR_, (uipr), 4)
@@ -3687,7 +3924,7 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define getUIP4R(uip4r)          getUIPR(uip4r)
 
 #define getUPORTR() \
-        ((((uint16_t)WIZCHIP_READ(_UPORTR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_UPORTR_,1)))
+        WIZCHIP_READ16(_UPORTR_)
 
 #define getUPORT4R()             getUPORTR()
 
@@ -3695,16 +3932,13 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_READ_BUF(_UIP6R_,(uip6r),16)
 
 #define getUPORT6R(uport6r) \
-        ((((uint16_t)WIZCHIP_READ(_UPORT6R_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_UPORT6R_,1)))
+        WIZCHIP_READ16(_UPORT6R_)
 
 #define setINTPTMR(intptmr) \
-        do{                                                                     \
-            WIZCHIP_WRITE(_INTPTMR_,(uint8_t)((intptmr) >> 8));                 \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_INTPTMR_,1),(uint8_t)(intptmr));  \
-       }while(0);
+        WIZCHIP_WRITE16(_INTPTMR_,(intptmr))
 
 #define getINTPTMR() \
-        ((((uint16_t)WIZCHIP_READ(_INTPTMR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_INTPTMR_,1)))
+        WIZCHIP_READ16(_INTPTMR_)
 
 #define getPLR() \
         WIZCHIP_READ(_PLR_)
@@ -3713,16 +3947,10 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_READ(_PFR_)
 
 #define getVLTR() \
-        ( (((uint32_t)WIZCHIP_READ(_VLTR_)) << 24) +                       \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_VLTR_,1))) << 16) + \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_VLTR_,2))) << 16) + \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_VLTR_,3))) << 16) )
+        WIZCHIP_READ32(_VLTR_)
 
 #define getPLTR() \
-        ( (((uint32_t)WIZCHIP_READ(_PLTR_)) << 24) +                       \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PLTR_,1))) << 16) + \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PLTR_,2))) << 16) + \
-          (((uint32_t)WIZCHIP_READ(WIZCHIP_OFFSET_INC(_PLTR_,3))) << 16) )
+        WIZCHIP_READ32(_PLTR_)
 
 #define getPAR(par) \
         WIZCHIP_READ_BUF(_PAR_, (par), 16)
@@ -3761,13 +3989,10 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define PHYUNLOCK()    setPHYLCKR(0x53)
 
 #define setRTR(rtr) \
-        do{                                                            \
-            WIZCHIP_WRITE(_RTR_,(uint8_t)((rtr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_RTR_,1),(uint8_t)(rtr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_RTR_,(rtr))
 
 #define getRTR() \
-        ((((uint16_t)WIZCHIP_READ(_RTR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_RTR_,1)))
+        WIZCHIP_READ16(_RTR_)
 
 #define setRCR(rcr) \
         WIZCHIP_WRITE(_RCR_,(rcr))
@@ -3776,13 +4001,10 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
         WIZCHIP_READ(_RCR_)
 
 #define setSLRTR(slrtr) \
-        do{                                                                \
-            WIZCHIP_WRITE(_SLRTR_,(uint8_t)((slrtr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_SLRTR_,1),(uint8_t)(slrtr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_SLRTR_,(slrtr))
 
 #define getSLRTR() \
-        ((((uint16_t)WIZCHIP_READ(_SLRTR_)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_SLRTR_,1)))
+        WIZCHIP_READ16(_SLRTR_)
 
 #define setSLRCR(slrcr) \
         WIZCHIP_WRITE(_SLRCR_,(slrcr))
@@ -3807,18 +4029,51 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
  * @addtogroup Socket_register_access_function_W6100
  * @{
  */
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_MR(sn,mr) \
+        do{                                                                                            \
+            WIZCHIP_SHADOW.sock[sn].MR = (mr);                                                         \
+            wiz_shadow_write(_Sn_MR_(sn), &WIZCHIP_SHADOW.sock[sn].MR, &WIZCHIP_SHADOW.sock[sn].MR, 1, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_MR);                            \
+        }while(0)
+#define getSn_MR(sn) \
+        (wiz_shadow_read(_Sn_MR_(sn), &WIZCHIP_SHADOW.sock[sn].MR, 0, 1, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_MR), \
+         WIZCHIP_SHADOW.sock[sn].MR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_MR(sn,mr) \
         WIZCHIP_WRITE(_Sn_MR_(sn),(mr))
 #define getSn_MR(sn) \
         WIZCHIP_READ(_Sn_MR_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setSn_PSR(sn,psr) \
         WIZCHIP_WRITE(_Sn_PSR_(sn),(psr))
 #define getSn_PSR(sn) \
         WIZCHIP_READ(_Sn_PSR_(sn))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_CR(sn,cr) \
+        do{                                                                           \
+            if((cr) == Sn_CR_LISTEN)                                                  \
+               WIZCHIP_SHADOW.sock[sn].valid &= ~(SHADOW_Sn_DIPR | SHADOW_Sn_DPORTR); \
+            WIZCHIP_WRITE(_Sn_CR_(sn),(cr));                                          \
+        }while(0)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_CR(sn,cr) \
         WIZCHIP_WRITE(_Sn_CR_(sn),(cr))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 #define getSn_CR(sn) \
         WIZCHIP_READ(_Sn_CR_(sn))
 
@@ -3862,38 +4117,63 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define getSn_HOPR(sn)           getSn_TTLR(sn)
 
 #define setSn_FRGR(sn,frgr) \
-        do{                                                                      \
-            WIZCHIP_WRITE(_Sn_FRGR_(sn),(uint8_t)((frgr)>>8));                   \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_FRGR_(sn),1),(uint8_t)(frgr));  \
-        }while(0);
+        WIZCHIP_WRITE16(_Sn_FRGR_(sn),(frgr))
 #define getSn_FRGR(sn,frgr) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_FRGR_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_FRGR_(sn),1)))
+        WIZCHIP_READ16(_Sn_FRGR_(sn))
 
 #define setSn_MSSR(sn,mssr) \
-        do{                                                                      \
-            WIZCHIP_WRITE(_Sn_MSSR_(sn),(uint8_t)((mssr)>>8));                   \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_MSSR_(sn),1),(uint8_t)(mssr));  \
-        }while(0);
+        WIZCHIP_WRITE16(_Sn_MSSR_(sn),(mssr))
 #define getSn_MSSR(sn) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_MSSR_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_MSSR_(sn),1)))
+        WIZCHIP_READ16(_Sn_MSSR_(sn))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
 #define setSn_PORTR(sn,portr) \
-        do{                                                                       \
-            WIZCHIP_WRITE(_Sn_PORTR_(sn),(uint8_t)((portr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_PORTR_(sn),1),(uint8_t)(portr)); \
-        }while(0);
+        do{                                                                                                   \
+            WIZCHIP_SHADOW.sock[sn].PORTR[0] = (uint8_t)((portr)>>8);                                         \
+            WIZCHIP_SHADOW.sock[sn].PORTR[1] = (uint8_t)(portr);                                              \
+            wiz_shadow_write(_Sn_PORTR_(sn), WIZCHIP_SHADOW.sock[sn].PORTR, WIZCHIP_SHADOW.sock[sn].PORTR, 2, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_PORTR);                                \
+        }while(0)
+#define getSn_PORTR(sn) \
+        (wiz_shadow_read(_Sn_PORTR_(sn), WIZCHIP_SHADOW.sock[sn].PORTR, 0, 2, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_PORTR), \
+         (((uint16_t)WIZCHIP_SHADOW.sock[sn].PORTR[0]) << 8) + WIZCHIP_SHADOW.sock[sn].PORTR[1])
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
+#define setSn_PORTR(sn,portr) \
+        WIZCHIP_WRITE16(_Sn_PORTR_(sn),(portr))
 #define getSn_PORTR(sn) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_PORTR_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_PORTR_(sn),1)))
+        WIZCHIP_READ16(_Sn_PORTR_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setSn_DHAR(sn,dhar) \
         WIZCHIP_WRITE_BUF(_Sn_DHAR_(sn),(dhar),6)
 #define getSn_DHAR(sn,dhar) \
         WIZCHIP_READ_BUF(_Sn_DHAR_(sn),(dhar),6)
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_DIPR(sn,dipr) \
+        wiz_shadow_write(_Sn_DIPR_(sn), WIZCHIP_SHADOW.sock[sn].DIPR, (dipr), 4, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_DIPR)
+#define getSn_DIPR(sn,dipr) \
+        (SHADOW_Sn_DST(sn) ?                                                                                                   \
+         wiz_shadow_read(_Sn_DIPR_(sn), WIZCHIP_SHADOW.sock[sn].DIPR, (dipr), 4, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_DIPR) : \
+         WIZCHIP_READ_BUF(_Sn_DIPR_(sn),(dipr),4))
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_DIPR(sn,dipr) \
         WIZCHIP_WRITE_BUF(_Sn_DIPR_(sn),(dipr),4)
 #define getSn_DIPR(sn,dipr) \
         WIZCHIP_READ_BUF(_Sn_DIPR_(sn),(dipr),4)
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setSn_DIP4R(sn,dipr)      setSn_DIPR(sn,(dipr))
 #define getSn_DIP4R(sn,dipr)      getSn_DIPR(sn,(dipr))
@@ -3903,26 +4183,59 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define getSn_DIP6R(sn,dip6r) \
         WIZCHIP_READ_BUF(_Sn_DIP6R_(sn),(dip6r),16)
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
 #define setSn_DPORTR(sn,dportr) \
-        do{                                                                         \
-            WIZCHIP_WRITE(_Sn_DPORTR_(sn),(uint8_t)((dportr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_DPORTR_(sn),1),(uint8_t)(dportr)); \
-        }while(0);
+        do{                                                                                                      \
+            WIZCHIP_SHADOW.sock[sn].DPORTR[0] = (uint8_t)((dportr)>>8);                                          \
+            WIZCHIP_SHADOW.sock[sn].DPORTR[1] = (uint8_t)(dportr);                                               \
+            wiz_shadow_write(_Sn_DPORTR_(sn), WIZCHIP_SHADOW.sock[sn].DPORTR, WIZCHIP_SHADOW.sock[sn].DPORTR, 2, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_DPORTR);                                  \
+        }while(0)
 #define getSn_DPORTR(sn) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_DPORTR_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_DPORTR_(sn),1)))
+        (SHADOW_Sn_DST(sn) ?                                                                                                          \
+         (wiz_shadow_read(_Sn_DPORTR_(sn), WIZCHIP_SHADOW.sock[sn].DPORTR, 0, 2, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_DPORTR), \
+          (((uint16_t)WIZCHIP_SHADOW.sock[sn].DPORTR[0]) << 8) + WIZCHIP_SHADOW.sock[sn].DPORTR[1]) :                              \
+         WIZCHIP_READ16(_Sn_DPORTR_(sn)))
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
+#define setSn_DPORTR(sn,dportr) \
+        WIZCHIP_WRITE16(_Sn_DPORTR_(sn),(dportr))
+#define getSn_DPORTR(sn) \
+        WIZCHIP_READ16(_Sn_DPORTR_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_MR2(sn,mr2) \
+        do{                                                                                               \
+            WIZCHIP_SHADOW.sock[sn].MR2 = (mr2);                                                          \
+            wiz_shadow_write(_Sn_MR2_(sn), &WIZCHIP_SHADOW.sock[sn].MR2, &WIZCHIP_SHADOW.sock[sn].MR2, 1, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_MR2);                              \
+        }while(0)
+#define getSn_MR2(sn) \
+        (wiz_shadow_read(_Sn_MR2_(sn), &WIZCHIP_SHADOW.sock[sn].MR2, 0, 1, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_MR2), \
+         WIZCHIP_SHADOW.sock[sn].MR2)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_MR2(sn,mr2) \
         WIZCHIP_WRITE(_Sn_MR2_(sn),(mr2))
 #define getSn_MR2(sn) \
         WIZCHIP_READ(_Sn_MR2_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #define setSn_RTR(sn,rtr) \
-        do{                                                                   \
-            WIZCHIP_WRITE(_Sn_RTR_(sn),(uint8_t)((rtr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_RTR_(sn),1),(uint8_t)(rtr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_Sn_RTR_(sn),(rtr))
 #define getSn_RTR(sn) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_RTR_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_RTR_(sn),1)))
+        WIZCHIP_READ16(_Sn_RTR_(sn))
 
 #define setSn_RCR(sn,rcr) \
         WIZCHIP_WRITE(_Sn_RCR_(sn),(rcr))
@@ -3934,12 +4247,39 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 #define getSn_KPALVTR(sn) \
         WIZCHIP_READ(_Sn_KPALVTR_(sn))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_TX_BSR(sn, tmsr) \
+        do{                                                                                                        \
+            WIZCHIP_SHADOW.sock[sn].TX_BSR = (tmsr);                                                               \
+            wiz_shadow_write(_Sn_TX_BSR_(sn), &WIZCHIP_SHADOW.sock[sn].TX_BSR, &WIZCHIP_SHADOW.sock[sn].TX_BSR, 1, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_TX_BSR);                                    \
+        }while(0)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_TX_BSR(sn, tmsr) \
         WIZCHIP_WRITE(_Sn_TX_BSR_(sn),(tmsr))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 #define setSn_TXBUF_SIZE(sn, tmsr)      setSn_TX_BSR(sn,(tmsr))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define getSn_TX_BSR(sn) \
+        (wiz_shadow_read(_Sn_TX_BSR_(sn), &WIZCHIP_SHADOW.sock[sn].TX_BSR, 0, 1, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_TX_BSR), \
+         WIZCHIP_SHADOW.sock[sn].TX_BSR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define getSn_TX_BSR(sn) \
         WIZCHIP_READ(_Sn_TX_BSR_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 #define getSn_TXBUF_SIZE(sn)            getSn_TX_BSR(sn)
               
 #define getSn_TxMAX(sn) \
@@ -3948,22 +4288,46 @@ void WIZCHIP_WRITE_BUF(uint32_t AddrSel, uint8_t* pBuf, datasize_t len);
 datasize_t getSn_TX_FSR(uint8_t sn);
 
 #define getSn_TX_RD(sn) \
-        ((((uint16_t)WIZCHIP_READ(_Sn_TX_RD_(sn))) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_TX_RD_(sn),1)))
+        WIZCHIP_READ16(_Sn_TX_RD_(sn))
 
 #define setSn_TX_WR(sn,txwr) \
-        do{                                                                       \
-            WIZCHIP_WRITE(_Sn_TX_WR_(sn), (uint8_t)((txwr)>>8));                  \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_TX_WR_(sn),1), (uint8_t)(txwr)); \
-        }while(0);
+        WIZCHIP_WRITE16(_Sn_TX_WR_(sn),(txwr))
 #define getSn_TX_WR(sn) \
-        (((uint16_t)WIZCHIP_READ(_Sn_TX_WR_(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_TX_WR_(sn),1)))
+        WIZCHIP_READ16(_Sn_TX_WR_(sn))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define setSn_RX_BSR(sn,rmsr) \
+        do{                                                                                                        \
+            WIZCHIP_SHADOW.sock[sn].RX_BSR = (rmsr);                                                               \
+            wiz_shadow_write(_Sn_RX_BSR_(sn), &WIZCHIP_SHADOW.sock[sn].RX_BSR, &WIZCHIP_SHADOW.sock[sn].RX_BSR, 1, \
+                             &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_RX_BSR);                                    \
+        }while(0)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define setSn_RX_BSR(sn,rmsr) \
         WIZCHIP_WRITE(_Sn_RX_BSR_(sn),(rmsr))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 #define setSn_RXBUF_SIZE(sn,rmsr)      setSn_RX_BSR(sn,(rmsr))
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_SHADOW_REG_ == 1)
+/// @endcond
+#define getSn_RX_BSR(sn) \
+        (wiz_shadow_read(_Sn_RX_BSR_(sn), &WIZCHIP_SHADOW.sock[sn].RX_BSR, 0, 1, &WIZCHIP_SHADOW.sock[sn].valid, SHADOW_Sn_RX_BSR), \
+         WIZCHIP_SHADOW.sock[sn].RX_BSR)
+/// @cond DOXY_APPLY_CODE
+#else
+/// @endcond
 #define getSn_RX_BSR(sn) \
         WIZCHIP_READ(_Sn_RX_BSR_(sn))
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 #define getSn_RXBUF_SIZE(sn)           getSn_RX_BSR(sn)
 
 #define getSn_RxMAX(sn) \
@@ -3972,16 +4336,13 @@ datasize_t getSn_TX_FSR(uint8_t sn);
 datasize_t getSn_RX_RSR(uint8_t s);
 
 #define setSn_RX_RD(sn,rxrd) \
-        do{                                                                        \
-            WIZCHIP_WRITE(_Sn_RX_RD_(sn), (uint8_t)((rxrd)>>8));                   \
-            WIZCHIP_WRITE(WIZCHIP_OFFSET_INC(_Sn_RX_RD_(sn),1), (uint8_t)(rxrd)) ; \
-        }while(0);
+        WIZCHIP_WRITE16(_Sn_RX_RD_(sn),(rxrd))
 
 #define getSn_RX_RD(sn) \
-        (((uint16_t)WIZCHIP_READ(_Sn_RX_RD_(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_RX_RD_(sn),1)))
+        WIZCHIP_READ16(_Sn_RX_RD_(sn))
 
 #define getSn_RX_WR(sn) \
-        (((uint16_t)WIZCHIP_READ(_Sn_RX_WR_(sn)) << 8) + WIZCHIP_READ(WIZCHIP_OFFSET_INC(_Sn_RX_WR_(sn),1)))
+        WIZCHIP_READ16(_Sn_RX_WR_(sn))
 /**
  * @}
  */
@@ -4027,6 +4388,60 @@ void wiz_recv_data(uint8_t sn, uint8_t *wizdata, datasize_t len);
  */
 void wiz_recv_ignore(uint8_t sn, datasize_t len);
 
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It starts to save data to be sent in the SOCKETn TX buffer and returns immediately.
+ * @details This function reads first @ref _Sn_TX_WR_ \n
+ *          and starts the SPI DMA transfer of <i>wizdata</i> registered by @ref reg_wizchip_spi_async_cbfunc().\n
+ *          @ref _Sn_TX_WR_ is increased as many as <i>len</i> in @ref wiz_async_done() on the completion,\n
+ *          and then <i>done</i> is called.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param wizdata Pointer buffer to write data. It should be kept until <i>done</i> is called.
+ * @param len Data length
+ * @param done Callback function called on the completion. It can be null.
+ * @return 0 : Started (or completed synchronously when no asynchronous callback is registered)\n
+ *         -1 : Another asynchronous transfer is pending.
+ * @note Any other access to @ref _WIZCHIP_ waits until @ref wiz_async_done() is called.
+ * @sa wiz_send_data(), wiz_recv_data_async(), wiz_async_done()
+ */
+int8_t wiz_send_data_async(uint8_t sn, uint8_t *wizdata, datasize_t len, void (*done)(uint8_t sn, datasize_t len));
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief It starts to copy the received data from the SOCKETn RX buffer and returns immediately.
+ * @details This function reads first @ref _Sn_RX_RD_ \n
+ *          and starts the SPI DMA transfer to <i>wizdata</i> registered by @ref reg_wizchip_spi_async_cbfunc().\n
+ *          @ref _Sn_RX_RD_ is increased as many as <i>len</i> in @ref wiz_async_done() on the completion,\n
+ *          and then <i>done</i> is called.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param wizdata Pointer buffer to read data. It is valid after <i>done</i> is called.
+ * @param len Data length
+ * @param done Callback function called on the completion. It can be null.
+ * @return 0 : Started (or completed synchronously when no asynchronous callback is registered)\n
+ *         -1 : Another asynchronous transfer is pending.
+ * @note Any other access to @ref _WIZCHIP_ waits until @ref wiz_async_done() is called.
+ * @sa wiz_recv_data(), wiz_send_data_async(), wiz_async_done()
+ */
+int8_t wiz_recv_data_async(uint8_t sn, uint8_t *wizdata, datasize_t len, void (*done)(uint8_t sn, datasize_t len));
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief Notifies the completion of the SPI DMA transfer started by the asynchronous callback function.
+ * @details It deselects @ref _WIZCHIP_, updates @ref _Sn_TX_WR_ or @ref _Sn_RX_RD_, releases @ref _WIZCHIP_ to the other accesses\n
+ *          and calls the <i>done</i> callback of @ref wiz_send_data_async() or @ref wiz_recv_data_async().\n
+ *          It doesn't enter or exit the critical section.
+ * @note Call it in your DMA completion handler.
+ * @sa reg_wizchip_spi_async_cbfunc()
+ */
+void wiz_async_done(void);
+
+/**
+ * @ingroup Basic_IO_function_W6100
+ * @brief Checks whether an asynchronous transfer is pending.
+ * @return 1 : Pending, 0 : Idle
+ */
+uint8_t wiz_async_busy(void);
+
 /// @cond DOXY_APPLY_CODE
 #if (_PHY_IO_MODE_ == _PHY_IO_MODE_MII_)
 /// @endcond
@@ -35,6 +35,7 @@
 //*****************************************************************************
 
 #include <stdio.h>
+#include <string.h>
 #include "socket.h"
 #include "w6100.h"
 
@@ -43,8 +44,30 @@
 static uint16_t sock_any_port = SOCK_ANY_PORT_NUM;
 static uint16_t sock_io_mode = 0;
 static uint16_t sock_is_sending = 0;
+static uint16_t sock_send_partial = 0;                         // SO_SENDPARTIAL of SOCKETn
 static datasize_t sock_remained_size[_WIZCHIP_SOCK_NUM_] = {0,0,};
 static uint8_t  sock_pack_info[_WIZCHIP_SOCK_NUM_] = {0,};
+static uint16_t sock_tx_base[_WIZCHIP_SOCK_NUM_] = {0,};
+static datasize_t sock_tx_rsv[_WIZCHIP_SOCK_NUM_] = {0,};
+static datasize_t sock_tx_credit[_WIZCHIP_SOCK_NUM_] = {0,};  // known free size of SOCKETn TX buffer without reading Sn_TX_FSR
+static uint16_t sock_cmd_pending = 0;                          // SOCKETn has the deferred Sn_CR command not yet cleared
+static uint16_t   sock_rx_rd[_WIZCHIP_SOCK_NUM_] = {0,};      // Sn_RX_RD of the data read by recv() but not committed
+static datasize_t sock_rx_pend[_WIZCHIP_SOCK_NUM_] = {0,};    // the byte size read by recv() but not committed
+static datasize_t sock_rx_avail[_WIZCHIP_SOCK_NUM_] = {0,};   // the byte size known to be readable without reading Sn_RX_RSR
+static datasize_t sock_rx_batch[_WIZCHIP_SOCK_NUM_] = {0,};   // SO_RECVBATCH threshold
+static volatile uint8_t sock_ir_latch[_WIZCHIP_SOCK_NUM_] = {0,}; // SENDOK and TIMEOUT of Sn_IR cleared by wiz_sock_isr()
+static uint16_t sock_poll_stale = 0xFFFF;                       // SOCKETn whose level state of wiz_poll() should be read again
+static uint8_t  sock_poll_level[_WIZCHIP_SOCK_NUM_] = {0,};     // level state of wiz_poll() : SIK_CONNECTED, SIK_DISCONNECTED, SIK_RECEIVED and SIK_SENT(free space)
+
+static volatile wiz_SockEvent sock_event_ring[SOCK_EVENT_RING_SIZE];
+static volatile uint8_t  sock_event_head = 0;                 // written only by wiz_sock_isr()
+static volatile uint8_t  sock_event_tail = 0;                 // written only by wiz_sock_event_get()
+static volatile uint16_t sock_event_lostcnt = 0;
+static uint8_t  sock_event_sockint = 0;
+static uint16_t sock_dgram_conn = 0;                           // SOCKETn is UDP mode and has the destination pinned by connect()
+static uint8_t  sock_dst_ip[_WIZCHIP_SOCK_NUM_][16];           // the last destination IP address written to Sn_DIPR or Sn_DIP6R
+static uint8_t  sock_dst_iplen[_WIZCHIP_SOCK_NUM_] = {0,};     // the length of sock_dst_ip. 0 : unknown
+static uint16_t sock_dst_port[_WIZCHIP_SOCK_NUM_] = {0,};      // the last destination port written to Sn_DPORTR. 0 : unknown
 
 
 #define CHECK_SOCKNUM()                                    \
@@ -89,6 +112,57 @@ static uint8_t  sock_pack_info[_WIZCHIP_SOCK_NUM_] = {0,};
       if(len == 0) return SOCKERR_DATALEN; \
    }while(0);     
 
+#if (SOCK_CMD_DEFERRED == 1)
+/* Wait for the deferred command of SOCKETn before accessing SOCKETn */
+#define SOCK_CMD_WAIT()                                      \
+   do{                                                       \
+      if(sock_cmd_pending & (1<<sn))                         \
+      {                                                      \
+         while(getSn_CR(sn));                                \
+         sock_cmd_pending &= ~(1<<sn);                       \
+      }                                                      \
+   }while(0);
+
+/* Issue a command without waiting for it to be cleared */
+#define SOCK_CMD_DEFER(cmd)                                  \
+   do{                                                       \
+      setSn_CR(sn,cmd);                                      \
+      sock_cmd_pending |= (1<<sn);                           \
+      sock_poll_stale  |= (1<<sn);                           \
+   }while(0);
+#else
+#define SOCK_CMD_WAIT()
+#define SOCK_CMD_DEFER(cmd)                                  \
+   do{                                                       \
+      setSn_CR(sn,cmd);                                      \
+      while(getSn_CR(sn));                                   \
+      sock_poll_stale |= (1<<sn);                            \
+   }while(0);
+#endif
+
+/* Sn_IR of SOCKETn including the bits cleared by wiz_sock_isr() */
+#define SOCK_GET_IR(sn)        (getSn_IR(sn) | sock_ir_latch[sn])
+
+/* Clear Sn_IR of SOCKETn and the bits latched by wiz_sock_isr() */
+#define SOCK_CLR_IR(sn, ir)                                  \
+   do{                                                       \
+      WIZCHIP_CRITICAL_ENTER();                              \
+      sock_ir_latch[sn] &= (uint8_t)~(ir);                   \
+      WIZCHIP_CRITICAL_EXIT();                               \
+      setSn_IRCLR(sn, ir);                                   \
+   }while(0);
+
+/* Commit Sn_RX_RD of the data read by recv() in SO_RECVBATCH mode */
+#define SOCK_RX_SYNC()                                       \
+   do{                                                       \
+      if(sock_rx_pend[sn])                                   \
+      {                                                      \
+         sock_rx_commit(sn);                                 \
+         SOCK_CMD_WAIT();                                    \
+      }                                                      \
+      sock_rx_avail[sn] = 0;                                 \
+   }while(0);
+
 #define CHECK_IPZERO(addr, addrlen)                                  \
    do{                                                               \
       uint16_t ipzero= 0;                                            \
@@ -98,6 +172,30 @@ static uint8_t  sock_pack_info[_WIZCHIP_SOCK_NUM_] = {0,};
 
 
 
+static void sock_rx_commit(uint8_t sn)
+{
+   setSn_RX_RD(sn, sock_rx_rd[sn]);
+   SOCK_CMD_DEFER(Sn_CR_RECV);
+   sock_rx_pend[sn] = 0;
+}
+
+/* Write the destination of SOCKETn only when it differs from the last one written. The port 0 is not written. */
+static void sock_set_dest(uint8_t sn, uint8_t * addr, uint8_t addrlen, uint16_t port)
+{
+   if((sock_dst_iplen[sn] != addrlen) || memcmp(sock_dst_ip[sn], addr, addrlen))
+   {
+      if(addrlen == 16) setSn_DIP6R(sn, addr);
+      else              setSn_DIPR(sn, addr);
+      memcpy(sock_dst_ip[sn], addr, addrlen);
+      sock_dst_iplen[sn] = addrlen;
+   }
+   if(port && (sock_dst_port[sn] != port))
+   {
+      setSn_DPORTR(sn, port);
+      sock_dst_port[sn] = port;
+   }
+}
+
 int8_t socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag)
 { 
    uint8_t taddr[16];
@@ -176,6 +274,14 @@ int8_t socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag)
    sock_is_sending &= ~(1<<sn);
    sock_remained_size[sn] = 0;
    sock_pack_info[sn] = PACK_NONE;
+   sock_tx_rsv[sn] = 0;
+   sock_tx_credit[sn] = getSn_TxMAX(sn);
+   sock_rx_pend[sn] = 0;
+   sock_rx_avail[sn] = 0;
+   sock_rx_batch[sn] = 0;
+   sock_dgram_conn &= ~(1<<sn);
+   sock_dst_iplen[sn] = 0;
+   sock_dst_port[sn] = 0;
 
    while(getSn_SR(sn) == SOCK_CLOSED) ;
 //   printf("[%d]%d\r\n", sn, getSn_PORTR(sn));
@@ -186,17 +292,29 @@ int8_t socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag)
 int8_t close(uint8_t sn)
 {
    CHECK_SOCKNUM();
+   SOCK_CMD_WAIT();
    setSn_CR(sn,Sn_CR_CLOSE);
    /* wait to process the command... */
    while( getSn_CR(sn) );
    /* clear all interrupt of SOCKETn. */
-   setSn_IRCLR(sn, 0xFF);
+   SOCK_CLR_IR(sn, 0xFF);
    /* Release the sock_io_mode of SOCKETn. */
    sock_io_mode &= ~(1<<sn); 
+   sock_send_partial &= ~(1<<sn);
    sock_remained_size[sn] = 0;
    sock_is_sending &= ~(1<<sn);
    sock_pack_info[sn] = PACK_NONE;
+   sock_tx_rsv[sn] = 0;
+   sock_tx_credit[sn] = 0;
+   sock_rx_pend[sn] = 0;
+   sock_rx_avail[sn] = 0;
+   sock_dgram_conn &= ~(1<<sn);
+   sock_dst_iplen[sn] = 0;
+   sock_dst_port[sn] = 0;
+   sock_poll_stale |= (1<<sn);
    while(getSn_SR(sn) != SOCK_CLOSED);
+   /* Redistribute the buffers if the buffer manager is started. */
+   if(wizchip_bufmgr_active()) wizchip_bufmgr_rebalance();
    return SOCK_OK;
 }
 
@@ -204,9 +322,11 @@ int8_t close(uint8_t sn)
 int8_t listen(uint8_t sn)
 {
    CHECK_SOCKNUM();
+   SOCK_CMD_WAIT();
    CHECK_SOCKINIT();
    setSn_CR(sn,Sn_CR_LISTEN);
    while(getSn_CR(sn));
+   sock_poll_stale |= (1<<sn);
    while(getSn_SR(sn) != SOCK_LISTEN)
    {
       close(sn);
@@ -218,8 +338,29 @@ int8_t listen(uint8_t sn)
 
 int8_t connect(uint8_t sn, uint8_t * addr, uint16_t port, uint8_t addrlen)
 { 
+   uint8_t tmp = 0;
 
    CHECK_SOCKNUM();
+   SOCK_CMD_WAIT();
+   tmp = getSn_MR(sn);
+   if((tmp & 0x03) == 0x02)   // Sn_MR_UDP4(0010), Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)
+   {
+      /* Pin the destination. No packet is sent. */
+      if(addrlen == 16)
+      {
+         if(!(tmp & 0x08)) return SOCKERR_SOCKMODE;
+      }
+      else if(addrlen == 4)
+      {
+         if(tmp == Sn_MR_UDP6) return SOCKERR_SOCKMODE;
+      }
+      else return SOCKERR_IPINVALID;
+      CHECK_IPZERO(addr, addrlen);
+      if(port == 0) return SOCKERR_PORTZERO;
+      sock_set_dest(sn, addr, addrlen, port);
+      sock_dgram_conn |= (1<<sn);
+      return SOCK_OK;
+   }
    CHECK_TCPMODE();
    CHECK_SOCKINIT();
   
@@ -245,14 +386,15 @@ int8_t connect(uint8_t sn, uint8_t * addr, uint16_t port, uint8_t addrlen)
       setSn_CR(sn,Sn_CR_CONNECT);
    }
    while(getSn_CR(sn));
+   sock_poll_stale |= (1<<sn);
 
    if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
 
    while(getSn_SR(sn) != SOCK_ESTABLISHED)
    {
-      if (getSn_IR(sn) & Sn_IR_TIMEOUT)
+      if (SOCK_GET_IR(sn) & Sn_IR_TIMEOUT)
       {
-         setSn_IRCLR(sn, Sn_IR_TIMEOUT);
+         SOCK_CLR_IR(sn, Sn_IR_TIMEOUT);
          return SOCKERR_TIMEOUT;
       }
       if (getSn_SR(sn) == SOCK_CLOSED)
@@ -266,16 +408,23 @@ int8_t connect(uint8_t sn, uint8_t * addr, uint16_t port, uint8_t addrlen)
 int8_t disconnect(uint8_t sn)
 {
    CHECK_SOCKNUM();
+   SOCK_CMD_WAIT();
+   if(sock_dgram_conn & (1<<sn))
+   {
+      sock_dgram_conn &= ~(1<<sn);   // The pinned destination is released.
+      return SOCK_OK;
+   }
    CHECK_TCPMODE();
    if(getSn_SR(sn) != SOCK_CLOSED)
    {
       setSn_CR(sn,Sn_CR_DISCON);
       /* wait to process the command... */
       while(getSn_CR(sn));
+      sock_poll_stale |= (1<<sn);
       if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
       while(getSn_SR(sn) != SOCK_CLOSED)
       {
-         if(getSn_IR(sn) & Sn_IR_TIMEOUT)
+         if(SOCK_GET_IR(sn) & Sn_IR_TIMEOUT)
          {
             close(sn);
             return SOCKERR_TIMEOUT;
@@ -286,9 +435,94 @@ int8_t disconnect(uint8_t sn)
 }
 
 
+/* Wait for SENDOK of the previous SEND in TCP mode */
+static int8_t sock_wait_stream_sent(uint8_t sn)
+{
+   uint8_t tmp = 0;
+   while ( !(SOCK_GET_IR(sn) & Sn_IR_SENDOK) )
+   {
+      tmp = getSn_SR(sn);
+      if ((tmp != SOCK_ESTABLISHED) && (tmp != SOCK_CLOSE_WAIT) )
+      {
+         if( (tmp == SOCK_CLOSED) || (SOCK_GET_IR(sn) & Sn_IR_TIMEOUT) ) close(sn);
+         return SOCKERR_SOCKSTATUS;
+      }
+      if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
+   }
+   SOCK_CLR_IR(sn, Sn_IR_SENDOK);
+   return SOCK_OK;
+}
+
+/* Wait for SENDOK of the datagram left in flight by sendmmsg() */
+static int8_t sock_wait_dgram_sent(uint8_t sn)
+{
+   uint8_t ir = 0;
+   while(sock_is_sending & (1<<sn))
+   {
+      ir = SOCK_GET_IR(sn);
+      if(ir & Sn_IR_SENDOK)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_SENDOK);
+         sock_is_sending  &= ~(1<<sn);
+         sock_cmd_pending &= ~(1<<sn);    // SEND is completed.
+         return SOCK_OK;
+      }
+      if(ir & Sn_IR_TIMEOUT)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_TIMEOUT);
+         sock_is_sending  &= ~(1<<sn);
+         sock_tx_credit[sn] = 0;
+         return SOCKERR_TIMEOUT;
+      }
+      if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
+   }
+   return SOCK_OK;
+}
+
+/* Send a datagram to the destination set in SOCKETn and wait for SENDOK */
+static datasize_t sock_send_dgram(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t tcmd)
+{
+   uint8_t tmp = 0;
+   uint16_t freesize = 0;
+
+   freesize = getSn_TxMAX(sn);
+   if (len > freesize) len = freesize; // check size not to exceed MAX size.
+  
+   while(1)
+   {
+      if(len > sock_tx_credit[sn]) sock_tx_credit[sn] = (datasize_t)getSn_TX_FSR(sn);
+      if(getSn_SR(sn) == SOCK_CLOSED) return SOCKERR_SOCKCLOSED;
+      if(len <= sock_tx_credit[sn]) break;
+      if( sock_io_mode & (1<<sn) ) return SOCK_BUSY;  
+   }
+   wiz_send_data(sn, buf, len);
+   sock_tx_credit[sn] -= len;
+   SOCK_CMD_DEFER(tcmd);
+  
+   while(1)
+   {
+      tmp = SOCK_GET_IR(sn);
+      if(tmp & Sn_IR_SENDOK)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_SENDOK);
+         sock_tx_credit[sn] = freesize;   // all data is sent out.
+         sock_cmd_pending &= ~(1<<sn);    // SEND is completed.
+         break;
+      }  
+      else if(tmp & Sn_IR_TIMEOUT)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_TIMEOUT);   
+         sock_tx_credit[sn] = 0;
+         return SOCKERR_TIMEOUT;
+      }
+   }  
+   return (int32_t)len;
+}
+
 datasize_t send(uint8_t sn, uint8_t * buf, datasize_t len)
 {
    uint8_t tmp=0;
+   int8_t  ret=0;
    datasize_t freesize=0;
    /* 
     * The below codes can be omitted for optmization of speed
@@ -296,44 +530,127 @@ datasize_t send(uint8_t sn, uint8_t * buf, datasize_t len)
    //CHECK_SOCKNUM();
    //CHECK_TCPMODE(Sn_MR_TCP4);
    /************/
+   SOCK_CMD_WAIT();
+   if(sock_dgram_conn & (1<<sn))
+   {
+      /* UDP SOCKETn connected by connect(). The destination is already set. */
+      ret = sock_wait_dgram_sent(sn);
+      if(ret != SOCK_OK) return ret;
+      return sock_send_dgram(sn, buf, len, (sock_dst_iplen[sn] == 16) ? Sn_CR_SEND6 : Sn_CR_SEND);
+   }
+   if((sock_send_partial & sock_io_mode & sock_is_sending) & (1<<sn))
+   {
+      /* Don't accept data until the previous SEND is completed. */
+      ret = sock_wait_stream_sent(sn);
+      if(ret != SOCK_OK) return ret;
+      sock_is_sending &= ~(1<<sn);
+   }
 
    freesize = getSn_TxMAX(sn);
    if (len > freesize) len = freesize; // check size not to exceed MAX size.
    while(1)
    {
-      freesize = (datasize_t)getSn_TX_FSR(sn);
+      if(len > sock_tx_credit[sn]) sock_tx_credit[sn] = (datasize_t)getSn_TX_FSR(sn);
       tmp = getSn_SR(sn);
       if ((tmp != SOCK_ESTABLISHED) && (tmp != SOCK_CLOSE_WAIT))
       {
          if(tmp == SOCK_CLOSED) close(sn);
          return SOCKERR_SOCKSTATUS;
       }
-      if(len <= freesize) break;
-      if( sock_io_mode & (1<<sn) ) return SOCK_BUSY;  
+      if(len <= sock_tx_credit[sn]) break;
+      if( sock_io_mode & (1<<sn) )
+      {
+         if((sock_send_partial & (1<<sn)) && (sock_tx_credit[sn] > 0))
+         {
+            len = sock_tx_credit[sn];   // send as many as it fits.
+            break;
+         }
+         return SOCK_BUSY;  
+      }
    }
    wiz_send_data(sn, buf, len);
+   sock_tx_credit[sn] -= len;
    if(sock_is_sending & (1<<sn))
    {
-      while ( !(getSn_IR(sn) & Sn_IR_SENDOK) )
-      {    
-         tmp = getSn_SR(sn);
-         if ((tmp != SOCK_ESTABLISHED) && (tmp != SOCK_CLOSE_WAIT) )
-         {
-            if( (tmp == SOCK_CLOSED) || (getSn_IR(sn) & Sn_IR_TIMEOUT) ) close(sn);
-            return SOCKERR_SOCKSTATUS;
-         }
-         if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
-      } 
-      setSn_IRCLR(sn, Sn_IR_SENDOK);
+      ret = sock_wait_stream_sent(sn);
+      if(ret != SOCK_OK) return ret;
    }
-   setSn_CR(sn,Sn_CR_SEND);
- 
-   while(getSn_CR(sn));   // wait to process the command...
+   SOCK_CMD_DEFER(Sn_CR_SEND);   // It is completed before the next access to SOCKETn.
    sock_is_sending |= (1<<sn);
  
    return len;
 }
 
+datasize_t sendv(uint8_t sn, const wiz_IoVec * iov, uint8_t iovcnt)
+{
+   uint8_t    tmp = 0, i = 0;
+   int8_t     ret = 0;
+   uint16_t   wr = 0;
+   int32_t    total = 0;
+   datasize_t len = 0, seg = 0, freesize = 0;
+
+   CHECK_SOCKNUM();
+   CHECK_TCPMODE();
+   if(!iov || (iovcnt == 0)) return SOCKERR_ARG;
+   for(i = 0; i < iovcnt; i++)
+   {
+      if(iov[i].iov_len < 0) return SOCKERR_DATALEN;
+      total += iov[i].iov_len;   // int32_t not to overflow with the segments of datasize_t
+   }
+   if(total == 0) return SOCKERR_DATALEN;
+   SOCK_CMD_WAIT();
+   if((sock_send_partial & sock_io_mode & sock_is_sending) & (1<<sn))
+   {
+      /* Don't accept data until the previous SEND is completed. */
+      ret = sock_wait_stream_sent(sn);
+      if(ret != SOCK_OK) return ret;
+      sock_is_sending &= ~(1<<sn);
+   }
+
+   freesize = getSn_TxMAX(sn);
+   len = (total > freesize) ? freesize : (datasize_t)total; // check size not to exceed MAX size.
+   while(1)
+   {
+      if(len > sock_tx_credit[sn]) sock_tx_credit[sn] = (datasize_t)getSn_TX_FSR(sn);
+      tmp = getSn_SR(sn);
+      if ((tmp != SOCK_ESTABLISHED) && (tmp != SOCK_CLOSE_WAIT))
+      {
+         if(tmp == SOCK_CLOSED) close(sn);
+         return SOCKERR_SOCKSTATUS;
+      }
+      if(len <= sock_tx_credit[sn]) break;
+      if( sock_io_mode & (1<<sn) )
+      {
+         if((sock_send_partial & (1<<sn)) && (sock_tx_credit[sn] > 0))
+         {
+            len = sock_tx_credit[sn];   // send as many as it fits.
+            break;
+         }
+         return SOCK_BUSY;
+      }
+   }
+   /* Write the segments consecutively into SOCKETn TX buffer */
+   wr = getSn_TX_WR(sn);
+   for(i = 0, freesize = len; (i < iovcnt) && freesize; i++)
+   {
+      seg = (iov[i].iov_len < freesize) ? iov[i].iov_len : freesize;
+      if(seg == 0) continue;
+      WIZCHIP_WRITE_BUF((((uint32_t)wr) << 8) + WIZCHIP_TXBUF_BLOCK(sn), iov[i].iov_base, seg);
+      wr += seg;
+      freesize -= seg;
+   }
+   setSn_TX_WR(sn, wr);
+   sock_tx_credit[sn] -= len;
+   if(sock_is_sending & (1<<sn))
+   {
+      ret = sock_wait_stream_sent(sn);
+      if(ret != SOCK_OK) return ret;
+   }
+   SOCK_CMD_DEFER(Sn_CR_SEND);   // It is completed before the next access to SOCKETn.
+   sock_is_sending |= (1<<sn);
+
+   return len;
+}
 
 datasize_t recv(uint8_t sn, uint8_t * buf, datasize_t len)
 {
@@ -346,7 +663,40 @@ datasize_t recv(uint8_t sn, uint8_t * buf, datasize_t len)
    //CHECK_TCPMODE();
    //CHECK_SOCKDATA();
    /************/
+   SOCK_CMD_WAIT();
  
+   if(sock_rx_batch[sn])
+   {
+      while(sock_rx_avail[sn] == 0)
+      {
+         recvsize = (datasize_t)getSn_RX_RSR(sn) - sock_rx_pend[sn];
+         tmp = getSn_SR(sn);
+         if (tmp != SOCK_ESTABLISHED && tmp != SOCK_CLOSE_WAIT)
+         {
+            if(tmp == SOCK_CLOSED) close(sn);
+            return SOCKERR_SOCKSTATUS;
+         }
+         if(recvsize > 0)
+         {
+            sock_rx_avail[sn] = recvsize;
+            break;
+         }
+         /* All the received data is read. Open the window while waiting. */
+         if(sock_rx_pend[sn]) sock_rx_commit(sn);
+         if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
+         SOCK_CMD_WAIT();
+      }
+      if(sock_rx_avail[sn] < len) len = sock_rx_avail[sn];
+      if(sock_rx_pend[sn] == 0) sock_rx_rd[sn] = getSn_RX_RD(sn);
+      WIZCHIP_READ_BUF((((uint32_t)sock_rx_rd[sn]) << 8) + WIZCHIP_RXBUF_BLOCK(sn), buf, len);
+      sock_rx_rd[sn] += len;
+      sock_rx_pend[sn] += len;
+      sock_rx_avail[sn] -= len;
+      /* Commit also when the data is drained, so that no data is left uncommitted until the next recv(). */
+      if(sock_rx_pend[sn] >= sock_rx_batch[sn] || sock_rx_avail[sn] == 0) sock_rx_commit(sn);
+      return len;
+   }
+
    recvsize = getSn_RxMAX(sn); 
    if(recvsize < len) len = recvsize;
    while(1)
@@ -363,8 +713,7 @@ datasize_t recv(uint8_t sn, uint8_t * buf, datasize_t len)
    }
    if(recvsize < len) len = recvsize;
    wiz_recv_data(sn, buf, len); 
-   setSn_CR(sn,Sn_CR_RECV); 
-   while(getSn_CR(sn));  
+   SOCK_CMD_DEFER(Sn_CR_RECV);
    return len;
 }
 
@@ -373,68 +722,36 @@ datasize_t sendto(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, uin
 {
    uint8_t tmp = 0;
    uint8_t tcmd = Sn_CR_SEND;
-   uint16_t freesize = 0;
+   int8_t  ret = 0;
    /* 
     * The below codes can be omitted for optmization of speed
     */
    //CHECK_SOCKNUM();
    //CHECK_DGRAMMODE();
    /************/
+   SOCK_CMD_WAIT();
+   if(sock_dgram_conn & (1<<sn)) return SOCKERR_SOCKSTATUS;   // use send() for the pinned destination.
+   ret = sock_wait_dgram_sent(sn);
+   if(ret != SOCK_OK) return ret;
    tmp = getSn_MR(sn);
    if(tmp != Sn_MR_MACRAW)
    {
        if (addrlen == 16)      // addrlen=16, Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)), IPRAW6(1011)
       {
-         if( tmp & 0x08)  
-         {
-            setSn_DIP6R(sn,addr);
-            tcmd = Sn_CR_SEND6;
-         }
+         if( tmp & 0x08)  tcmd = Sn_CR_SEND6;
          else return SOCKERR_SOCKMODE;
       } 
       else if(addrlen == 4)      // addrlen=4, Sn_MR_UDP4(0010), Sn_MR_UDPD(1110), IPRAW4(0011)
       {
          if(tmp == Sn_MR_UDP6 || tmp == Sn_MR_IPRAW6) return SOCKERR_SOCKMODE;
-         setSn_DIPR(sn,addr);
          tcmd = Sn_CR_SEND;
       }
       else return SOCKERR_IPINVALID;
+      if(((tmp & 0x03)==0x02) && (port == 0)) return SOCKERR_PORTZERO;  // Sn_MR_UPD4(0010), Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)
+      /* Rewrite only the changed destination registers. */
+      sock_set_dest(sn, addr, addrlen, ((tmp & 0x03)==0x02) ? port : 0);
    }
-   if((tmp & 0x03)==0x02)     // Sn_MR_UPD4(0010), Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)
-   {
-      if(port){ setSn_DPORTR(sn, port);}
-      else   return SOCKERR_PORTZERO;
-   }
-  
-   freesize = getSn_TxMAX(sn);
-   if (len > freesize) len = freesize; // check size not to exceed MAX size.
-  
-   while(1)
-   {
-      freesize = getSn_TX_FSR(sn);
-      if(getSn_SR(sn) == SOCK_CLOSED) return SOCKERR_SOCKCLOSED;
-      if(len <= freesize) break;
-      if( sock_io_mode & (1<<sn) ) return SOCK_BUSY;  
-   }
-   wiz_send_data(sn, buf, len);
-   setSn_CR(sn,tcmd);
-   while(getSn_CR(sn));
-  
-   while(1)
-   {
-      tmp = getSn_IR(sn);
-      if(tmp & Sn_IR_SENDOK)
-      {
-         setSn_IRCLR(sn, Sn_IR_SENDOK);
-         break;
-      }  
-      else if(tmp & Sn_IR_TIMEOUT)
-      {
-         setSn_IRCLR(sn, Sn_IR_TIMEOUT);   
-         return SOCKERR_TIMEOUT;
-      }
-   }  
-   return (int32_t)len;
+   return sock_send_dgram(sn, buf, len, tcmd);
 }
 
 
@@ -450,6 +767,7 @@ datasize_t recvfrom(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, u
    //CHECK_DGRAMMODE();
    //CHECK_SOCKDATA();
    /************/
+   SOCK_CMD_WAIT();
   
    if(sock_remained_size[sn] == 0)
    {
@@ -466,8 +784,6 @@ datasize_t recvfrom(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, u
       };
       /* First read 2 bytes of PACKET INFO in SOCKETn RX buffer*/
       wiz_recv_data(sn, head, 2);  
-      setSn_CR(sn,Sn_CR_RECV);
-      while(getSn_CR(sn));
       pack_len = head[0] & 0x07;
       pack_len = (pack_len << 8) + head[1];
     
@@ -483,8 +799,6 @@ datasize_t recvfrom(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, u
             if(sock_pack_info[sn] & PACK_IPv6) *addrlen = 16;
             else *addrlen = 4;
             wiz_recv_data(sn, addr, *addrlen);
-            setSn_CR(sn,Sn_CR_RECV);
-            while(getSn_CR(sn));
             break;
          case Sn_MR_MACRAW :
 			pack_len-=2;
@@ -506,17 +820,14 @@ datasize_t recvfrom(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, u
          if(port==0) return SOCKERR_ARG;
          wiz_recv_data(sn, head, 2);
          *port = ( ((((uint16_t)head[0])) << 8) + head[1] );
-         setSn_CR(sn,Sn_CR_RECV);
-         while(getSn_CR(sn));   
       }
    }   
    
    if   (len < sock_remained_size[sn]) pack_len = len;
    else pack_len = sock_remained_size[sn];    
    wiz_recv_data(sn, buf, pack_len);
-   setSn_CR(sn,Sn_CR_RECV);  
-   /* wait to process the command... */
-   while(getSn_CR(sn)) ;
+   /* PACKET INFO and data are released by one RECV. It is completed before the next access to SOCKETn. */
+   SOCK_CMD_DEFER(Sn_CR_RECV);
  
    sock_remained_size[sn] -= pack_len; 
    if(sock_remained_size[sn] != 0) sock_pack_info[sn] |= PACK_REMAINED; 
@@ -575,6 +886,7 @@ int8_t ctlsocket(uint8_t sn, ctlsock_type cstype, void* arg)
 
 int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg)
 {
+   uint8_t tmp = 0;
    CHECK_SOCKNUM();
    switch(sotype)
    {
@@ -588,21 +900,26 @@ int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg)
          setSn_MSSR(sn,*(uint16_t*)arg);
          break;
       case SO_DESTIP:
-         if(((wiz_IPAddress*)arg)->len == 16) setSn_DIP6R(sn, ((wiz_IPAddress*)arg)->ip);
-         else           setSn_DIPR(sn, ((wiz_IPAddress*)arg)->ip);
+         tmp = (((wiz_IPAddress*)arg)->len == 16) ? 16 : 4;
+         if(tmp == 16) setSn_DIP6R(sn, ((wiz_IPAddress*)arg)->ip);
+         else          setSn_DIPR(sn, ((wiz_IPAddress*)arg)->ip);
+         memcpy(sock_dst_ip[sn], ((wiz_IPAddress*)arg)->ip, tmp);
+         sock_dst_iplen[sn] = tmp;
          break;
       case SO_DESTPORT:
          setSn_DPORTR(sn, *(uint16_t*)arg);
+         sock_dst_port[sn] = *(uint16_t*)arg;
          break;
       case SO_KEEPALIVESEND:
          CHECK_TCPMODE();   
          if(getSn_KPALVTR(sn) != 0) return SOCKERR_SOCKOPT;
+         SOCK_CMD_WAIT();
          setSn_CR(sn,Sn_CR_SEND_KEEP);
          while(getSn_CR(sn) != 0)
          {     
-            if (getSn_IR(sn) & Sn_IR_TIMEOUT)
+            if (SOCK_GET_IR(sn) & Sn_IR_TIMEOUT)
             {
-               setSn_IRCLR(sn, Sn_IR_TIMEOUT);
+               SOCK_CLR_IR(sn, Sn_IR_TIMEOUT);
                return SOCKERR_TIMEOUT;
             }
          }
@@ -611,6 +928,25 @@ int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg)
          CHECK_TCPMODE();
          setSn_KPALVTR(sn,*(uint8_t*)arg);
          break;   
+      case SO_RECVBATCH:
+         CHECK_TCPMODE();
+         if(*(datasize_t*)arg < 0) return SOCKERR_SOCKOPT;
+         SOCK_CMD_WAIT();
+         SOCK_RX_SYNC();
+         sock_rx_batch[sn] = *(datasize_t*)arg;
+         if(sock_rx_batch[sn] > (getSn_RxMAX(sn) >> 1)) sock_rx_batch[sn] = getSn_RxMAX(sn) >> 1;
+         break;
+      case SO_SENDPARTIAL:
+         CHECK_TCPMODE();
+         if(*(uint8_t*)arg == 1)      sock_send_partial |= (1<<sn);
+         else if(*(uint8_t*)arg == 0) sock_send_partial &= ~(1<<sn);
+         else return SOCKERR_SOCKOPT;
+         break;
+      case SO_RECVFLUSH:
+         CHECK_TCPMODE();
+         SOCK_CMD_WAIT();
+         if(sock_rx_pend[sn]) sock_rx_commit(sn);
+         break;
       default:
          return SOCKERR_ARG;
    } 
@@ -620,6 +956,7 @@ int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg)
 int8_t getsockopt(uint8_t sn, sockopt_type sotype, void* arg)
 {
    CHECK_SOCKNUM();
+   SOCK_CMD_WAIT();
    switch(sotype)
    {
       case SO_FLAG:
@@ -658,7 +995,7 @@ int8_t getsockopt(uint8_t sn, sockopt_type sotype, void* arg)
          *(datasize_t*) arg = getSn_TX_FSR(sn);
          break;
       case SO_RECVBUF:
-         *(datasize_t*) arg = getSn_RX_RSR(sn);
+         *(datasize_t*) arg = getSn_RX_RSR(sn) - sock_rx_pend[sn];
          break;
       case SO_STATUS:
          *(uint8_t*) arg = getSn_SR(sn);
@@ -677,6 +1014,12 @@ int8_t getsockopt(uint8_t sn, sockopt_type sotype, void* arg)
          if(getSn_MR(sn) & 0x01)       return SOCKERR_SOCKMODE;
          else *(uint8_t*)arg = sock_pack_info[sn];
          break;
+      case SO_RECVBATCH:
+         *(datasize_t*) arg = sock_rx_batch[sn];
+         break;
+      case SO_SENDPARTIAL:
+         *(uint8_t*) arg = (uint8_t)((sock_send_partial >> sn) & 0x0001);
+         break;
       case SO_MODE:
          *(uint8_t*) arg = 0x0F & getSn_MR(sn);
          break;
@@ -686,25 +1029,737 @@ int8_t getsockopt(uint8_t sn, sockopt_type sotype, void* arg)
    return SOCK_OK;
 }
 
+datasize_t wiz_tx_reserve(uint8_t sn, datasize_t len)
+{
+   uint8_t tmp = 0;
+   CHECK_SOCKNUM();
+   CHECK_SOCKDATA();
+   SOCK_CMD_WAIT();
+   if(len > getSn_TxMAX(sn)) return SOCKERR_DATALEN;
+   while(1)
+   {
+      if(len > sock_tx_credit[sn]) sock_tx_credit[sn] = (datasize_t)getSn_TX_FSR(sn);
+      tmp = getSn_SR(sn);
+      if(tmp == SOCK_CLOSED) return SOCKERR_SOCKCLOSED;
+      if( ((getSn_MR(sn) & 0x03) == 0x01) && (tmp != SOCK_ESTABLISHED) && (tmp != SOCK_CLOSE_WAIT) ) return SOCKERR_SOCKSTATUS;
+      if(len <= sock_tx_credit[sn]) break;
+      if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
+   }
+   sock_tx_base[sn] = getSn_TX_WR(sn);
+   sock_tx_rsv[sn]  = len;
+   return len;
+}
+
+datasize_t wiz_tx_write(uint8_t sn, datasize_t off, uint8_t * buf, datasize_t len)
+{
+   CHECK_SOCKNUM();
+   CHECK_SOCKDATA();
+   if((off < 0) || (len < 0) || ((off + len) > sock_tx_rsv[sn])) return SOCKERR_DATALEN;
+   WIZCHIP_WRITE_BUF(WIZCHIP_OFFSET_INC((((uint32_t)sock_tx_base[sn]) << 8) + WIZCHIP_TXBUF_BLOCK(sn), (uint32_t)off), buf, len);
+   return len;
+}
+
+datasize_t wiz_tx_commit(uint8_t sn)
+{
+   uint8_t tmp = 0;
+   int8_t  ret = 0;
+   uint8_t tcmd = Sn_CR_SEND;
+   datasize_t len = 0;
+   CHECK_SOCKNUM();
+   len = sock_tx_rsv[sn];
+   if(len == 0) return SOCKERR_DATALEN;
+   SOCK_CMD_WAIT();
+   tmp = getSn_MR(sn);
+   if((tmp & 0x03) == 0x01)      // TCP
+   {
+      if(sock_is_sending & (1<<sn))
+      {
+         ret = sock_wait_stream_sent(sn);
+         if(ret != SOCK_OK) return ret;
+      }
+      setSn_TX_WR(sn, sock_tx_base[sn] + len);
+      sock_tx_rsv[sn] = 0;
+      sock_tx_credit[sn] -= len;
+      SOCK_CMD_DEFER(Sn_CR_SEND);
+      sock_is_sending |= (1<<sn);
+      return len;
+   }
+   if(tmp == Sn_MR_UDP6 || tmp == Sn_MR_IPRAW6) tcmd = Sn_CR_SEND6;
+   else if(sock_dst_iplen[sn] == 16) tcmd = Sn_CR_SEND6;   // Sn_MR_UDPD to the IPv6 destination set by connect(), sendto() or SO_DESTIP
+   ret = sock_wait_dgram_sent(sn);
+   if(ret != SOCK_OK) return ret;
+   setSn_TX_WR(sn, sock_tx_base[sn] + len);
+   sock_tx_rsv[sn] = 0;
+   sock_tx_credit[sn] -= len;
+   SOCK_CMD_DEFER(tcmd);
+   while(1)
+   {
+      tmp = SOCK_GET_IR(sn);
+      if(tmp & Sn_IR_SENDOK)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_SENDOK);
+         sock_tx_credit[sn] = getSn_TxMAX(sn);   // all data is sent out.
+         sock_cmd_pending &= ~(1<<sn);           // SEND is completed.
+         break;
+      }
+      else if(tmp & Sn_IR_TIMEOUT)
+      {
+         SOCK_CLR_IR(sn, Sn_IR_TIMEOUT);
+         sock_tx_credit[sn] = 0;
+         return SOCKERR_TIMEOUT;
+      }
+   }
+   return len;
+}
+
+datasize_t wiz_rx_peek(uint8_t sn, datasize_t off, uint8_t * buf, datasize_t len)
+{
+   datasize_t recvsize = 0;
+   CHECK_SOCKNUM();
+   CHECK_SOCKDATA();
+   if((off < 0) || (len < 0)) return SOCKERR_DATALEN;
+   SOCK_CMD_WAIT();
+   SOCK_RX_SYNC();
+   recvsize = getSn_RX_RSR(sn);
+   if(off >= recvsize) return 0;
+   if(len > (recvsize - off)) len = recvsize - off;
+   WIZCHIP_READ_BUF(WIZCHIP_OFFSET_INC((((uint32_t)getSn_RX_RD(sn)) << 8) + WIZCHIP_RXBUF_BLOCK(sn), (uint32_t)off), buf, len);
+   return len;
+}
+
+datasize_t wiz_rx_consume(uint8_t sn, datasize_t len)
+{
+   CHECK_SOCKNUM();
+   CHECK_SOCKDATA();
+   SOCK_CMD_WAIT();
+   SOCK_RX_SYNC();
+   if((len < 0) || (len > getSn_RX_RSR(sn))) return SOCKERR_DATALEN;
+   setSn_RX_RD(sn, getSn_RX_RD(sn) + len);
+   SOCK_CMD_DEFER(Sn_CR_RECV);
+   return len;
+}
+
+datasize_t wiz_rx_walk(uint8_t sn, uint8_t * chunk, datasize_t chunksize, int8_t (*cb)(uint8_t sn, datasize_t off, uint8_t * chunk, datasize_t len, void * arg), void * arg)
+{
+   uint32_t   rx_ptr = 0;
+   datasize_t recvsize = 0, off = 0, len = 0;
+   CHECK_SOCKNUM();
+   if((chunksize <= 0) || !cb) return SOCKERR_ARG;
+   SOCK_CMD_WAIT();
+   SOCK_RX_SYNC();
+   recvsize = getSn_RX_RSR(sn);
+   rx_ptr = (((uint32_t)getSn_RX_RD(sn)) << 8) + WIZCHIP_RXBUF_BLOCK(sn);
+   while(off < recvsize)
+   {
+      len = recvsize - off;
+      if(len > chunksize) len = chunksize;
+      WIZCHIP_READ_BUF(rx_ptr, chunk, len);
+      off += len;
+      if(cb(sn, off - len, chunk, len, arg)) break;
+      rx_ptr = WIZCHIP_OFFSET_INC(rx_ptr, (uint32_t)len);
+   }
+   return off;
+}
+
+/* Read the level state of SOCKETn for wiz_poll() */
+static void sock_poll_sync(uint8_t sn)
+{
+   uint8_t sr = getSn_SR(sn);
+   uint8_t level = 0;
+   if(sr == SOCK_CLOSED || sr == SOCK_CLOSE_WAIT) level |= SIK_DISCONNECTED;
+   if(sr == SOCK_ESTABLISHED) level |= SIK_CONNECTED;
+   /* SOCK_UDP, SOCK_IPRAW4, SOCK_IPRAW6 and SOCK_MACRAW are 0x22 or more. */
+   if(sr == SOCK_ESTABLISHED || sr == SOCK_CLOSE_WAIT || sr >= SOCK_UDP)
+   {
+      if(sock_rx_avail[sn] || ((datasize_t)getSn_RX_RSR(sn) > sock_rx_pend[sn])) level |= SIK_RECEIVED;
+      if((sock_tx_credit[sn] > 0) || getSn_TX_FSR(sn)) level |= SIK_SENT;
+   }
+   sock_poll_level[sn] = level;
+   sock_poll_stale &= ~(1<<sn);
+}
+
+int16_t wiz_poll(wiz_PollFd* fds, uint8_t nfds, int32_t timeout)
+{
+   uint8_t  i = 0, sn = 0, sir = 0, ir = 0;
+   uint16_t tick = 0, now = 0;
+   int32_t  elapsed = 0;
+   int16_t  cnt = 0;
+
+   if(!fds) return SOCKERR_ARG;
+   for(i = 0; i < nfds; i++)
+      if(fds[i].sn >= _WIZCHIP_SOCK_NUM_) return SOCKERR_SOCKNUM;
+   if(timeout > 0) tick = getTCNTR();
+   while(1)
+   {
+      cnt = 0;
+      sir = getSIR();
+      for(i = 0; i < nfds; i++)
+      {
+         sn = fds[i].sn;
+         fds[i].revents = 0;
+         /* Touch only SOCKETn with an edge in Sn_IR or the latch, or with the stale level state. */
+         if((sir & (1<<sn)) || sock_ir_latch[sn] || (sock_poll_stale & (1<<sn)))
+         {
+            SOCK_CMD_WAIT();
+            if((sir & (1<<sn)) || sock_ir_latch[sn])
+            {
+               /* All the edges are taken. CON, DISCON and RECV are kept as the level state. */
+               ir = SOCK_GET_IR(sn) & SIK_ALL;
+               if(ir)
+               {
+                  SOCK_CLR_IR(sn, ir);
+                  /* Resolve the pending send like sock_wait_dgram_sent() */
+                  if(ir & Sn_IR_SENDOK)
+                  {
+                     sock_is_sending  &= ~(1<<sn);
+                     sock_cmd_pending &= ~(1<<sn);    // SEND is completed.
+                  }
+                  if(ir & Sn_IR_TIMEOUT)
+                  {
+                     sock_is_sending  &= ~(1<<sn);
+                     sock_tx_credit[sn] = 0;
+                  }
+                  fds[i].revents = ir & (fds[i].events | SIK_DISCONNECTED | SIK_TIMEOUT) & (SIK_CONNECTED | SIK_DISCONNECTED | SIK_TIMEOUT);
+               }
+            }
+            sock_poll_sync(sn);
+         }
+         /* Level : the state kept in host memory */
+         fds[i].revents |= sock_poll_level[sn] & (fds[i].events | SIK_DISCONNECTED) & (uint8_t)~SIK_SENT;
+         if((fds[i].events & SIK_SENT) && (sock_poll_level[sn] & SIK_SENT) && !(sock_is_sending & (1<<sn)))
+            fds[i].revents |= SIK_SENT;
+         if(fds[i].revents) cnt++;
+      }
+      if(cnt || (timeout == 0)) return cnt;
+      if(timeout > 0)
+      {
+         now = getTCNTR();
+         elapsed += (uint16_t)(now - tick);    // 100us tick
+         tick = now;
+         if((elapsed / 10) >= timeout) return 0;
+      }
+   }
+}
+
 int16_t peeksockmsg(uint8_t sn, uint8_t* submsg, uint16_t subsize)
 {
    uint32_t rx_ptr = 0;
-   uint16_t i = 0, sub_idx = 0;
-
-   if( (getSn_RX_RSR(sn) > 0) && (subsize > 0) )
-   {
-       rx_ptr = ((uint32_t)getSn_RX_RD(sn) << 8)  + WIZCHIP_RXBUF_BLOCK(sn);
-       sub_idx = 0;
-       for(i = 0; i < getSn_RX_RSR(sn) ; i++)
-       {
-          if(WIZCHIP_READ(rx_ptr) == submsg[sub_idx])
-          {
-              sub_idx++;
-              if(sub_idx == subsize) return (i + 1 - sub_idx);
-          }
-          else sub_idx = 0;
-          rx_ptr = WIZCHIP_OFFSET_INC(rx_ptr,1);
-       }
+   uint16_t recvsize = 0, i = 0, j = 0, len = 0, sub_idx = 0;
+   uint8_t  chunk[SOCK_PEEK_CHUNK_SIZE];
+   uint16_t fail[SOCK_PEEK_SUBMSG_MAX];
+
+   if( (subsize == 0) || (subsize > SOCK_PEEK_SUBMSG_MAX) ) return -1;
+   SOCK_CMD_WAIT();
+   SOCK_RX_SYNC();
+   recvsize = getSn_RX_RSR(sn);
+   if(recvsize < subsize) return -1;
+
+   /* KMP failure function of submsg */
+   fail[0] = 0;
+   for(i = 1; i < subsize; i++)
+   {
+      while(sub_idx && (submsg[i] != submsg[sub_idx])) sub_idx = fail[sub_idx-1];
+      if(submsg[i] == submsg[sub_idx]) sub_idx++;
+      fail[i] = sub_idx;
+   }
+
+   sub_idx = 0;
+   rx_ptr = ((uint32_t)getSn_RX_RD(sn) << 8)  + WIZCHIP_RXBUF_BLOCK(sn);
+   for(i = 0; i < recvsize; i += len)
+   {
+      len = recvsize - i;
+      if(len > SOCK_PEEK_CHUNK_SIZE) len = SOCK_PEEK_CHUNK_SIZE;
+      WIZCHIP_READ_BUF(rx_ptr, chunk, len);
+      for(j = 0; j < len; j++)
+      {
+         while(sub_idx && (chunk[j] != submsg[sub_idx])) sub_idx = fail[sub_idx-1];
+         if(chunk[j] == submsg[sub_idx]) sub_idx++;
+         if(sub_idx == subsize) return (i + j + 1 - subsize);
+      }
+      rx_ptr = WIZCHIP_OFFSET_INC(rx_ptr,(uint32_t)len);
    }
    return -1;
 }
+
+int16_t recvmmsg(uint8_t sn, uint8_t * buf, datasize_t bufsize, wiz_MMsg * msgs, uint8_t vlen)
+{
+   uint8_t    mr = 0, i = 0, info = 0;
+   uint16_t   rd = 0;
+   int16_t    cnt = 0;
+   datasize_t recvsize = 0, pos = 0, hlen = 0, plen = 0;
+
+   CHECK_SOCKNUM();
+   mr = getSn_MR(sn) & 0x0F;
+   if((mr == Sn_MR_CLOSE) || ((mr & 0x03) == 0x01)) return SOCKERR_SOCKMODE;
+   if(!buf || !msgs || (vlen == 0) || (bufsize < 2)) return SOCKERR_ARG;
+   SOCK_CMD_WAIT();
+   if(sock_remained_size[sn] != 0) return SOCKERR_SOCKSTATUS;
+   while(1)
+   {
+      recvsize = getSn_RX_RSR(sn);
+      if(recvsize != 0) break;
+      if(getSn_SR(sn) == SOCK_CLOSED) return SOCKERR_SOCKCLOSED;
+      if(sock_io_mode & (1<<sn)) return SOCK_BUSY;
+   }
+   if(recvsize > bufsize) recvsize = bufsize;
+   rd = getSn_RX_RD(sn);
+   WIZCHIP_READ_BUF((((uint32_t)rd) << 8) + WIZCHIP_RXBUF_BLOCK(sn), buf, recvsize);
+   /* Parse PACKET INFO in host memory */
+   while((cnt < vlen) && ((pos + 2) <= recvsize))
+   {
+      info = buf[pos] & 0xF8;
+      plen = ((datasize_t)(buf[pos] & 0x07) << 8) + buf[pos+1];
+      if(mr == Sn_MR_MACRAW)
+      {
+         plen -= 2;
+         if((plen < 0) || (plen > 1514))
+         {
+            close(sn);
+            return SOCKFATAL_PACKLEN;
+         }
+         info = PACK_NONE;
+         hlen = 2;
+         msgs[cnt].addrlen = 0;
+         msgs[cnt].port = 0;
+      }
+      else
+      {
+         msgs[cnt].addrlen = (info & PACK_IPv6) ? 16 : 4;
+         hlen = 2 + msgs[cnt].addrlen;
+         if((mr & 0x03) == 0x02) hlen += 2;     // Sn_MR_UDP4(0010), Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)
+      }
+      if((pos + hlen + plen) > recvsize) break;
+      if(mr != Sn_MR_MACRAW)
+      {
+         for(i = 0; i < msgs[cnt].addrlen; i++) msgs[cnt].addr[i] = buf[pos + 2 + i];
+         if((mr & 0x03) == 0x02) msgs[cnt].port = ((uint16_t)buf[pos + hlen - 2] << 8) + buf[pos + hlen - 1];
+         else                    msgs[cnt].port = 0;
+      }
+      msgs[cnt].buf = &buf[pos + hlen];
+      msgs[cnt].len = plen;
+      msgs[cnt].packinfo = info | PACK_FIRST | PACK_COMPLETED;
+      pos += hlen + plen;
+      cnt++;
+   }
+   if(cnt == 0) return SOCKERR_BUFFER;
+   setSn_RX_RD(sn, rd + pos);
+   /* All the read datagrams are released by one RECV. */
+   SOCK_CMD_DEFER(Sn_CR_RECV);
+   return cnt;
+}
+
+int16_t sendmmsg(uint8_t sn, wiz_MMsg * msgs, uint8_t vlen)
+{
+   uint8_t    mr = 0, tcmd = Sn_CR_SEND;
+   uint16_t   wr = 0;
+   int16_t    cnt = 0;
+   int8_t     ret = 0;
+   datasize_t len = 0, txmax = 0;
+
+   CHECK_SOCKNUM();
+   mr = getSn_MR(sn);
+   if(((mr & 0x0F) == Sn_MR_CLOSE) || ((mr & 0x03) == 0x01)) return SOCKERR_SOCKMODE;
+   if(!msgs || (vlen == 0)) return SOCKERR_ARG;
+   SOCK_CMD_WAIT();
+   if(sock_dgram_conn & (1<<sn)) return SOCKERR_SOCKSTATUS;
+   txmax = getSn_TxMAX(sn);
+   wr = getSn_TX_WR(sn);
+   for(cnt = 0; cnt < vlen; cnt++)
+   {
+      len = msgs[cnt].len;
+      if((len <= 0) || (len > txmax)) return cnt ? cnt : SOCKERR_DATALEN;
+      if(mr != Sn_MR_MACRAW)
+      {
+         if(msgs[cnt].addrlen == 16)         // Sn_MR_UDP6(1010), Sn_MR_UDPD(1110), IPRAW6(1011)
+         {
+            if(!(mr & 0x08)) return cnt ? cnt : SOCKERR_SOCKMODE;
+            tcmd = Sn_CR_SEND6;
+         }
+         else if(msgs[cnt].addrlen == 4)     // Sn_MR_UDP4(0010), Sn_MR_UDPD(1110), IPRAW4(0011)
+         {
+            if(mr == Sn_MR_UDP6 || mr == Sn_MR_IPRAW6) return cnt ? cnt : SOCKERR_SOCKMODE;
+            tcmd = Sn_CR_SEND;
+         }
+         else return cnt ? cnt : SOCKERR_IPINVALID;
+         if(((mr & 0x03) == 0x02) && (msgs[cnt].port == 0)) return cnt ? cnt : SOCKERR_PORTZERO;
+      }
+      while(len > sock_tx_credit[sn])
+      {
+         sock_tx_credit[sn] = (datasize_t)getSn_TX_FSR(sn);
+         if(len <= sock_tx_credit[sn]) break;
+         if(getSn_SR(sn) == SOCK_CLOSED) return cnt ? cnt : SOCKERR_SOCKCLOSED;
+         if(sock_io_mode & (1<<sn)) return cnt;   // SOCK_BUSY when nothing is sent
+      }
+      /* Write the payload while the previous datagram is being sent. */
+      WIZCHIP_WRITE_BUF((((uint32_t)wr) << 8) + WIZCHIP_TXBUF_BLOCK(sn), msgs[cnt].buf, len);
+      sock_tx_credit[sn] -= len;
+      if(sock_is_sending & (1<<sn))
+      {
+         ret = sock_wait_dgram_sent(sn);
+         if(ret != SOCK_OK)
+         {
+            if(ret == SOCKERR_TIMEOUT) cnt--;    // the previous datagram is not sent.
+            else sock_tx_credit[sn] += len;      // SOCK_BUSY. The payload is written again by the next call.
+            return (cnt > 0) ? cnt : ret;
+         }
+         sock_tx_credit[sn] = txmax - len;       // all data except this payload is sent out.
+      }
+      /* Rewrite only the changed destination registers. */
+      if(mr != Sn_MR_MACRAW)
+         sock_set_dest(sn, msgs[cnt].addr, msgs[cnt].addrlen, ((mr & 0x03) == 0x02) ? msgs[cnt].port : 0);
+      wr += len;
+      setSn_TX_WR(sn, wr);
+      SOCK_CMD_DEFER(tcmd);
+      sock_is_sending |= (1<<sn);     // SENDOK is checked by the next datagram or the next call.
+   }
+   return cnt;
+}
+
+int8_t wiz_sock_event_init(intr_kind intr, uint8_t sockint, uint16_t intptime)
+{
+   uint8_t sn;
+   uint8_t simr = (uint8_t)((uint32_t)intr >> 8);
+   setSYCR1(getSYCR1() & ~SYCR1_IEN);
+   for(sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++)
+      if(simr & (1<<sn)) setSn_IMR(sn, sockint);
+   wizchip_setinterruptmask(intr);
+   setINTPTMR(intptime);
+   sock_event_sockint = sockint;
+   sock_event_tail = sock_event_head;
+   sock_event_lostcnt = 0;
+   setSYCR1(getSYCR1() | SYCR1_IEN);
+   return SOCK_OK;
+}
+
+static void sock_event_push(uint8_t sn, uint8_t ir)
+{
+   uint8_t head = sock_event_head;
+   if((uint8_t)(head - sock_event_tail) >= SOCK_EVENT_RING_SIZE)
+   {
+      sock_event_lostcnt++;
+      return;
+   }
+   sock_event_ring[head & (SOCK_EVENT_RING_SIZE-1)].sn = sn;
+   sock_event_ring[head & (SOCK_EVENT_RING_SIZE-1)].ir = ir;
+   sock_event_head = head + 1;               // publish after the event is written.
+}
+
+void wiz_sock_isr(void)
+{
+   uint8_t sn, ir, cnt = 0;
+   uint8_t intr[3];     // IR, SIR, SLIR
+
+   WIZCHIP_READ_BUF(_IR_, intr, 3);
+   if(intr[0])
+   {
+      setIRCLR(intr[0]);
+      sock_event_push(SOCK_EVENT_NET, intr[0]);
+      cnt++;
+   }
+   for(sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++)
+   {
+      if(!(intr[1] & (1<<sn))) continue;
+      ir = getSn_IR(sn) & sock_event_sockint;
+      if(!ir) continue;
+      setSn_IRCLR(sn, ir);
+      sock_ir_latch[sn] |= ir & (Sn_IR_SENDOK | Sn_IR_TIMEOUT);
+      sock_event_push(sn, ir);
+      cnt++;
+   }
+   if(intr[2])
+   {
+      setSLIRCLR(intr[2]);
+      sock_event_push(SOCK_EVENT_SOCKL, intr[2]);
+      cnt++;
+   }
+   wizchip_intrmod_update(cnt);
+}
+
+int8_t wiz_sock_event_get(wiz_SockEvent* ev)
+{
+   uint8_t tail = sock_event_tail;
+   if(tail == sock_event_head) return SOCK_BUSY;
+   ev->sn = sock_event_ring[tail & (SOCK_EVENT_RING_SIZE-1)].sn;
+   ev->ir = sock_event_ring[tail & (SOCK_EVENT_RING_SIZE-1)].ir;
+   sock_event_tail = tail + 1;               // release the slot after the event is read.
+   return SOCK_OK;
+}
+
+uint16_t wiz_sock_event_lost(void)
+{
+   uint16_t ret;
+   WIZCHIP_CRITICAL_ENTER();
+   ret = sock_event_lostcnt;
+   sock_event_lostcnt = 0;
+   WIZCHIP_CRITICAL_EXIT();
+   return ret;
+}
+
+/* Open SOCKETn of the listener pool and listen */
+static int8_t sock_pool_arm(wiz_ListenPool* pool, uint8_t sn)
+{
+   int8_t ret;
+   ret = socket(sn, pool->protocol, pool->port, pool->flag);
+   if(ret != (int8_t)sn) return ret;
+   return listen(sn);
+}
+
+int8_t wiz_listen_pool(wiz_ListenPool* pool, uint8_t protocol, uint16_t port, uint8_t flag, uint16_t sockmask)
+{
+   uint8_t sn;
+   int8_t  ret;
+   if(!pool) return SOCKERR_ARG;
+   sockmask &= (uint16_t)((1 << _WIZCHIP_SOCK_NUM_) - 1);
+   if(sockmask == 0) return SOCKERR_ARG;
+   if(port == 0) return SOCKERR_PORTZERO;
+   if((protocol & 0x03) != 0x01) return SOCKERR_SOCKMODE;   // Sn_MR_TCP4(0001), Sn_MR_TCP6(1001), Sn_MR_TCPD(1101)
+   pool->port     = port;
+   pool->protocol = protocol;
+   pool->flag     = flag;
+   pool->sockmask = 0;
+   pool->accepted = 0;
+   pool->next     = 0;
+   for(sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++)
+   {
+      if(!(sockmask & (1<<sn))) continue;
+      ret = sock_pool_arm(pool, sn);
+      if(ret != SOCK_OK)
+      {
+         wiz_listen_pool_close(pool);
+         return ret;
+      }
+      pool->sockmask |= (1<<sn);
+   }
+   return SOCK_OK;
+}
+
+int8_t wiz_accept(wiz_ListenPool* pool, uint8_t* sn)
+{
+   uint8_t i, s, sr;
+   int8_t  ret = SOCK_BUSY;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      s = (pool->next + i) % _WIZCHIP_SOCK_NUM_;
+      if(!(pool->sockmask & (1<<s))) continue;
+      sr = getSn_SR(s);
+      if(pool->accepted & (1<<s))
+      {
+         if(sr != SOCK_CLOSED) continue;     // used by the application
+         pool->accepted &= ~(1<<s);
+      }
+      if(sr == SOCK_CLOSED)
+      {
+         sock_pool_arm(pool, s);            // listen again. If it fails, it is tried again by the next call.
+         continue;
+      }
+      if((ret == SOCK_BUSY) && ((sr == SOCK_ESTABLISHED) || (sr == SOCK_CLOSE_WAIT)))
+      {
+         pool->accepted |= (1<<s);
+         pool->next = (s + 1) % _WIZCHIP_SOCK_NUM_;
+         *sn = s;
+         ret = SOCK_OK;
+      }
+   }
+   return ret;
+}
+
+int8_t wiz_listen_pool_close(wiz_ListenPool* pool)
+{
+   uint8_t sn;
+   for(sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++)
+   {
+      if((pool->sockmask & ~pool->accepted) & (1<<sn)) close(sn);
+   }
+   pool->sockmask = 0;
+   pool->accepted = 0;
+   return SOCK_OK;
+}
+
+/* Copy into the queue of the flow after the queued datagrams */
+static void sock_flow_put(wiz_UdpFlow* flow, const uint8_t* buf, datasize_t len)
+{
+   datasize_t tail, n;
+   tail = (flow->qhead + flow->qlen) % flow->qsize;
+   n = flow->qsize - tail;
+   if(n > len) n = len;
+   memcpy(flow->qbuf + tail, buf, n);
+   memcpy(flow->qbuf, buf + n, len - n);
+   flow->qlen += len;
+}
+
+/* Copy out of the queue of the flow from the first datagram. buf can be NULL to discard. */
+static void sock_flow_get(wiz_UdpFlow* flow, uint8_t* buf, datasize_t len)
+{
+   datasize_t n;
+   n = flow->qsize - flow->qhead;
+   if(n > len) n = len;
+   if(buf)
+   {
+      memcpy(buf, flow->qbuf + flow->qhead, n);
+      memcpy(buf + n, flow->qbuf, len - n);
+   }
+   flow->qhead = (flow->qhead + len) % flow->qsize;
+   flow->qlen -= len;
+}
+
+/* Queue the datagram to the flow of its source. It returns 1 if queued. */
+static uint8_t sock_flow_route(wiz_UdpMux* mux, wiz_MMsg* msg)
+{
+   wiz_UdpFlow* flow;
+   wiz_UdpFlow* any = 0;
+   uint8_t  head[5];
+   datasize_t hlen = 2;
+   for(flow = mux->flows; flow; flow = flow->next)
+   {
+      if(flow->addrlen == 0) any = flow;
+      else if((flow->port == msg->port) && (flow->addrlen == msg->addrlen) && !memcmp(flow->addr, msg->addr, msg->addrlen)) break;
+   }
+   if(!flow) flow = any;
+   if(!flow)
+   {
+      mux->drops++;
+      return 0;
+   }
+   head[0] = (uint8_t)(msg->len >> 8);
+   head[1] = (uint8_t)msg->len;
+   if(flow->addrlen == 0)     // keep the source with the datagram.
+   {
+      head[2] = msg->addrlen;
+      head[3] = (uint8_t)(msg->port >> 8);
+      head[4] = (uint8_t)msg->port;
+      hlen = 5 + msg->addrlen;
+   }
+   if((datasize_t)(flow->qsize - flow->qlen) < (datasize_t)(hlen + msg->len))
+   {
+      flow->drops++;
+      return 0;
+   }
+   sock_flow_put(flow, head, (hlen > 5) ? 5 : hlen);
+   if(hlen > 5) sock_flow_put(flow, msg->addr, msg->addrlen);
+   sock_flow_put(flow, msg->buf, msg->len);
+   return 1;
+}
+
+int8_t wiz_udpmux_open(wiz_UdpMux* mux, uint8_t sn, uint16_t port, uint8_t flag, uint8_t* buf, datasize_t bufsize)
+{
+   int8_t  ret;
+   uint8_t mode = SOCK_IO_NONBLOCK;
+   if(!mux || !buf || (bufsize == 0)) return SOCKERR_ARG;
+   ret = socket(sn, Sn_MR_UDPD, port, flag);
+   if(ret != (int8_t)sn) return ret;
+   ctlsocket(sn, CS_SET_IOMODE, &mode);
+   mux->sn      = sn;
+   mux->buf     = buf;
+   mux->bufsize = bufsize;
+   mux->flows   = 0;
+   mux->drops   = 0;
+   return SOCK_OK;
+}
+
+int8_t wiz_udpmux_close(wiz_UdpMux* mux)
+{
+   close(mux->sn);
+   mux->flows = 0;
+   return SOCK_OK;
+}
+
+int8_t wiz_udpflow_add(wiz_UdpMux* mux, wiz_UdpFlow* flow, uint8_t* addr, uint8_t addrlen, uint16_t port, uint8_t* qbuf, datasize_t qsize)
+{
+   wiz_UdpFlow* f;
+   if(!mux || !flow || !qbuf || (qsize < 3)) return SOCKERR_ARG;
+   if((addrlen != 0) && (addrlen != 4) && (addrlen != 16)) return SOCKERR_IPINVALID;
+   if(addrlen && (port == 0)) return SOCKERR_PORTZERO;
+   for(f = mux->flows; f; f = f->next)
+   {
+      if(f == flow) return SOCKERR_ARG;
+      if((f->addrlen == addrlen) && ((addrlen == 0) || ((f->port == port) && !memcmp(f->addr, addr, addrlen)))) return SOCKERR_ARG;
+   }
+   if(addrlen) memcpy(flow->addr, addr, addrlen);
+   flow->addrlen = addrlen;
+   flow->port    = addrlen ? port : 0;
+   flow->sn      = mux->sn;
+   flow->qbuf    = qbuf;
+   flow->qsize   = qsize;
+   flow->qhead   = 0;
+   flow->qlen    = 0;
+   flow->drops   = 0;
+   flow->next    = mux->flows;
+   mux->flows    = flow;
+   return SOCK_OK;
+}
+
+int8_t wiz_udpflow_remove(wiz_UdpMux* mux, wiz_UdpFlow* flow)
+{
+   wiz_UdpFlow** pf;
+   for(pf = &mux->flows; *pf; pf = &(*pf)->next)
+   {
+      if(*pf == flow)
+      {
+         *pf = flow->next;
+         flow->next = 0;
+         return SOCK_OK;
+      }
+   }
+   return SOCKERR_ARG;
+}
+
+int16_t wiz_udpmux_poll(wiz_UdpMux* mux)
+{
+   wiz_MMsg   msgs[SOCK_UDPMUX_BATCH];
+   int16_t    cnt = 0, n, i;
+   uint8_t    addr[16], addrlen;
+   uint16_t   port;
+   datasize_t ret;
+   while(1)
+   {
+      n = recvmmsg(mux->sn, mux->buf, mux->bufsize, msgs, SOCK_UDPMUX_BATCH);
+      if((n == SOCKERR_BUFFER) || (n == SOCKERR_SOCKSTATUS))
+      {
+         /* Drop the datagram not fitting the buffer. */
+         do{
+            ret = recvfrom(mux->sn, mux->buf, mux->bufsize, addr, &port, &addrlen);
+         }while((ret > 0) && sock_remained_size[mux->sn]);
+         if(ret <= 0) return cnt ? cnt : n;
+         mux->drops++;
+         continue;
+      }
+      if(n == SOCK_BUSY) break;
+      if(n < 0) return cnt ? cnt : n;
+      for(i = 0; i < n; i++) cnt += sock_flow_route(mux, &msgs[i]);
+   }
+   return cnt;
+}
+
+datasize_t wiz_udpflow_recv(wiz_UdpFlow* flow, uint8_t* buf, datasize_t len, uint8_t* addr, uint16_t* port, uint8_t* addrlen)
+{
+   uint8_t    head[3];
+   uint8_t    taddr[16];
+   datasize_t dlen;
+   if(flow->qlen == 0) return SOCK_BUSY;
+   sock_flow_get(flow, head, 2);
+   dlen = ((datasize_t)head[0] << 8) | head[1];
+   if(flow->addrlen == 0)
+   {
+      sock_flow_get(flow, head, 3);
+      sock_flow_get(flow, taddr, head[0]);
+      if(addr)    memcpy(addr, taddr, head[0]);
+      if(addrlen) *addrlen = head[0];
+      if(port)    *port = ((uint16_t)head[1] << 8) | head[2];
+   }
+   else
+   {
+      if(addr)    memcpy(addr, flow->addr, flow->addrlen);
+      if(addrlen) *addrlen = flow->addrlen;
+      if(port)    *port = flow->port;
+   }
+   if(len > dlen) len = dlen;
+   sock_flow_get(flow, buf, len);
+   sock_flow_get(flow, 0, dlen - len);   // discard the rest.
+   return len;
+}
+
+datasize_t wiz_udpflow_send(wiz_UdpFlow* flow, uint8_t* buf, datasize_t len)
+{
+   if(flow->addrlen == 0) return SOCKERR_IPINVALID;
+   return sendto(flow->sn, buf, len, flow->addr, flow->port, flow->addrlen);
+}
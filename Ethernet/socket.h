@@ -79,6 +79,37 @@
 
 #define SOCKET               uint8_t  ///< SOCKET type define for legacy driver
 
+/**
+ * @brief Defer the completion of @ref Sn_CR_SEND and @ref Sn_CR_RECV.
+ * @details If it is 1, @ref send(), @ref recv(), @ref sendto() and @ref recvfrom() don't wait for @ref _Sn_CR_ to be cleared.\n
+ *          The pending command is checked before the next access to the SOCKET by the SOCKET APIs.\n
+ *          It is 0 by default, so the SOCKET APIs complete their commands before returning.
+ * @note If it is 1 and you read @ref _Sn_RX_RSR_ or @ref _Sn_TX_FSR_ directly right after them, the value may not be updated yet.\n
+ *       Use @ref getsockopt() with @ref SO_RECVBUF or @ref SO_SENDBUF instead.
+ *       The applications of Internet directory such as DHCP and DNS read @ref _Sn_RX_RSR_ directly, so keep it 0 with them.
+ */
+#ifndef SOCK_CMD_DEFERRED
+   #define SOCK_CMD_DEFERRED        0
+#endif
+
+#ifndef SOCK_PEEK_CHUNK_SIZE
+   #define SOCK_PEEK_CHUNK_SIZE     32    ///< The byte size of a burst read of SOCKETn RX buffer in @ref peeksockmsg()
+#endif
+#ifndef SOCK_PEEK_SUBMSG_MAX
+   #define SOCK_PEEK_SUBMSG_MAX     32    ///< The max byte length of a sub-message to find in @ref peeksockmsg()
+#endif
+
+#ifndef SOCK_EVENT_RING_SIZE
+   #define SOCK_EVENT_RING_SIZE     16    ///< The count of events queued by @ref wiz_sock_isr(). It should be a power of 2 and not greater than 128.
+#endif
+
+#ifndef SOCK_UDPMUX_BATCH
+   #define SOCK_UDPMUX_BATCH        8     ///< The count of datagrams read at once by @ref wiz_udpmux_poll()
+#endif
+
+#define SOCK_EVENT_NET       0xF0     ///< @ref wiz_SockEvent::sn of the events of @ref _IR_
+#define SOCK_EVENT_SOCKL     0xF1     ///< @ref wiz_SockEvent::sn of the events of @ref _SLIR_
+
 #define SOCK_OK              1        ///< Result is OK about socket process.
 #define SOCK_BUSY            0        ///< Socket is busy on processing the operation. Valid only Non-block IO Mode.
 #define SOCK_FATAL           (-1000)    ///< Result is fatal error about socket process.
@@ -222,10 +253,12 @@ int8_t socket(uint8_t sn, uint8_t protocol, uint16_t port, uint8_t flag);
 /**
  * @ingroup WIZnet_socket_APIs
  * @brief Close a SOCKET.
- * @details It closes the SOCKET  with <b>'sn'</b> passed as parameter.
+ * @details It closes the SOCKET  with <b>'sn'</b> passed as parameter.\n
+ *          If the buffer manager is started by @ref wizchip_bufmgr_init(), the buffers of the closed SOCKETs are redistributed.
  * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
  * @return Success : @ref SOCK_OK \n
  *         Fail    : @ref SOCKERR_SOCKNUM - Invalid SOCKET number
+ * @sa wizchip_bufmgr_rebalance()
  */
 int8_t close(uint8_t sn);
 
@@ -260,9 +293,13 @@ int8_t listen(uint8_t sn);
  *                     @ref SOCKERR_PORTZERO  - Server port zero\n
  *                     @ref SOCKERR_TIMEOUT   - Timeout occurred during request connection\n
  *                     @ref SOCK_BUSY         - In non-block io mode, it returns immediately\n
- * @note It is valid only in TCP client mode. \n
+ * @note It is valid in TCP client mode and UDP mode such as @ref Sn_MR_UDP4, @ref Sn_MR_UDP6, and @ref Sn_MR_UDPD. \n
  *       In block io mode, it does not return until connection is completed. \n
- *       In Non-block io mode(@ref SF_IO_NONBLOCK), it returns @ref SOCK_BUSY immediately.
+ *       In Non-block io mode(@ref SF_IO_NONBLOCK), it returns @ref SOCK_BUSY immediately. \n
+ *       In UDP mode, it sends nothing and returns @ref SOCK_OK immediately. It only pins the destination of SOCKET <i>sn</i> 
+ *       so that @ref send() sends datagrams without setting the destination registers, until @ref disconnect() or @ref close(). \n
+ *       While the destination is pinned, @ref sendto() and @ref sendmmsg() return @ref SOCKERR_SOCKSTATUS. \n
+ *       The received datagrams are not filtered by the pinned destination.
  */
 int8_t connect(uint8_t sn, uint8_t * addr, uint16_t port, uint8_t addrlen);
 
@@ -277,9 +314,11 @@ int8_t connect(uint8_t sn, uint8_t * addr, uint16_t port, uint8_t addrlen);
  *                     @ref SOCKERR_SOCKMODE - Invalid operation in the SOCKET \n
  *                     @ref SOCKERR_TIMEOUT  - Timeout occurred \n
  *                     @ref SOCK_BUSY        - In non-block io mode, it returns immediately.
- * @note It is valid only in TCP mode such as @ref Sn_MR_TCP4, @ref Sn_MR_TCP6, and @ref Sn_MR_TCPD. \n
+ * @note It is valid only in TCP mode such as @ref Sn_MR_TCP4, @ref Sn_MR_TCP6, and @ref Sn_MR_TCPD, 
+ *       or in UDP mode connected by @ref connect(). \n
  *       In block io mode, it does not return until disconnection is completed. \n
  *       In Non-block io mode(@ref SF_IO_NONBLOCK), it returns @ref SOCK_BUSY immediately. \n
+ *       In UDP mode, it only releases the pinned destination and returns @ref SOCK_OK.
  */
 int8_t disconnect(uint8_t sn);
 
@@ -300,6 +339,9 @@ int8_t disconnect(uint8_t sn);
  *       It can send data as many as SOCKET TX buffer size if data is greater than SOCKET TX buffer size. \n
  *       In block io mode, It doesn't return until data sending is completed when SOCKET transmittable buffer size is greater than data. \n
  *       In non-block io mode(@ref SF_IO_NONBLOCK), It return @ref SOCK_BUSY immediately when SOCKET transmittable buffer size is not enough or the previous sent data is not completed. \n
+ *       If @ref SO_SENDPARTIAL is set in non-block io mode, it sends data as many as SOCKET transmittable buffer size instead of @ref SOCK_BUSY. \n
+ *       In UDP mode connected by @ref connect(), it sends a datagram to the pinned destination like @ref sendto() 
+ *       without writing the destination registers.
  */
 datasize_t send(uint8_t sn, uint8_t * buf, datasize_t len);
 
@@ -351,7 +393,10 @@ datasize_t recv(uint8_t sn, uint8_t * buf, datasize_t len);
  *       In UDP mode, It can send data as many as SOCKET RX buffer size if data is greater than SOCKET TX buffer size. \n
  *       In IPRAW and MACRAW mode, It should send data as many as MTU(maxium transmission unit) if data is greater than MTU. That is, <i>len</i> can't exceed to MTU.
  *       In block io mode, It doesn't return until data send is completed. 
- *       In non-block io mode(@ref SF_IO_NONBLOCK), It return @ref SOCK_BUSY immediately when SOCKET transimttable buffer size is not enough.
+ *       In non-block io mode(@ref SF_IO_NONBLOCK), It return @ref SOCK_BUSY immediately when SOCKET transimttable buffer size is not enough. \n
+ *       The destination registers are written only when <i>addr</i> or <i>port</i> differs from the last destination of SOCKET <i>sn</i>. 
+ *       If you write them directly by @ref setSn_DIPR() or @ref setSn_DPORTR(), use @ref setsockopt() with @ref SO_DESTIP and @ref SO_DESTPORT instead. \n
+ *       It returns @ref SOCKERR_SOCKSTATUS if the destination is pinned by @ref connect().
  */
 datasize_t sendto(uint8_t sn, uint8_t * buf, datasize_t len, uint8_t * addr, uint16_t port, uint8_t addrlen);
 
@@ -410,6 +455,101 @@ typedef enum
    SIK_ALL           = 0x1F         ///< all interrupt
 }sockint_kind;
 
+/**
+ * @ingroup DATA_TYPE
+ * @brief SOCKET descriptor of @ref wiz_poll().
+ * @details <i>events</i> and <i>revents</i> are the bits of @ref sockint_kind.
+ */
+typedef struct wiz_pollfd
+{
+   uint8_t sn;          ///< SOCKET number
+   uint8_t events;      ///< Requested events. @ref SIK_DISCONNECTED and @ref SIK_TIMEOUT are always returned.
+   uint8_t revents;     ///< Returned events
+}wiz_PollFd;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Data segment of @ref sendv().
+ */
+typedef struct wiz_iovec
+{
+   uint8_t*   iov_base; ///< The data of the segment
+   datasize_t iov_len;  ///< The byte length of <i>iov_base</i>
+}wiz_IoVec;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Message descriptor of @ref recvmmsg().
+ */
+typedef struct wiz_mmsg
+{
+   uint8_t*   buf;      ///< The received data. It points into the buffer given to @ref recvmmsg().
+   datasize_t len;      ///< The byte length of <i>buf</i>
+   uint8_t    addr[16]; ///< The source IP address. Not valid in @ref Sn_MR_MACRAW.
+   uint8_t    addrlen;  ///< The byte length of <i>addr</i>. 4 or 16, and 0 in @ref Sn_MR_MACRAW.
+   uint16_t   port;     ///< The source port number. Valid only in UDP mode.
+   uint8_t    packinfo; ///< The packet information such as @ref PACK_IPv6 and @ref PACK_COMPLETED
+}wiz_MMsg;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief The event queued by @ref wiz_sock_isr().
+ */
+typedef struct wiz_sockevent
+{
+   uint8_t sn;          ///< SOCKET number, @ref SOCK_EVENT_NET or @ref SOCK_EVENT_SOCKL
+   uint8_t ir;          ///< The bits of @ref sockint_kind for SOCKETn, of @ref _IR_ for @ref SOCK_EVENT_NET, or of @ref _SLIR_ for @ref SOCK_EVENT_SOCKL
+}wiz_SockEvent;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief TCP listener pool of @ref wiz_listen_pool() and @ref wiz_accept().
+ * @details The members are managed by @ref wiz_listen_pool() and @ref wiz_accept(). Don't modify them.
+ */
+typedef struct wiz_listenpool
+{
+   uint16_t port;       ///< The listen port number
+   uint8_t  protocol;   ///< @ref Sn_MR_TCP4, @ref Sn_MR_TCP6, or @ref Sn_MR_TCPD
+   uint8_t  flag;       ///< The SOCKET flag passed to @ref socket()
+   uint16_t sockmask;   ///< The SOCKETs of the pool. Bit n is SOCKETn.
+   uint16_t accepted;   ///< The SOCKETs handed to the application by @ref wiz_accept()
+   uint8_t  next;       ///< The SOCKET checked first by the next @ref wiz_accept()
+}wiz_ListenPool;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Logical UDP flow of @ref wiz_UdpMux.
+ * @details It is keyed by the remote IP address and port number, and has the host queue of the received datagrams.\n
+ *          The members are managed by @ref wiz_udpflow_add(), @ref wiz_udpmux_poll() and @ref wiz_udpflow_recv(). Don't modify them.
+ */
+typedef struct wiz_udpflow
+{
+   uint8_t    addr[16];     ///< The remote IP address
+   uint8_t    addrlen;      ///< 4 or 16. 0 receives the datagrams of the peers without their own flow.
+   uint16_t   port;         ///< The remote port number
+   uint8_t    sn;           ///< The SOCKET of @ref wiz_UdpMux
+   uint8_t*   qbuf;         ///< The queue memory
+   datasize_t qsize;        ///< The byte size of <i>qbuf</i>
+   datasize_t qhead;        ///< The offset of the first queued datagram in <i>qbuf</i>
+   datasize_t qlen;         ///< The byte length of the queued datagrams
+   uint16_t   drops;        ///< The count of datagrams dropped by the full queue
+   struct wiz_udpflow* next;
+}wiz_UdpFlow;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief UDP flow multiplexer of @ref wiz_udpmux_open().
+ * @details Many @ref wiz_UdpFlow share one @ref Sn_MR_UDPD SOCKET. Don't modify the members.
+ */
+typedef struct wiz_udpmux
+{
+   uint8_t      sn;         ///< The SOCKET number
+   uint8_t*     buf;        ///< The buffer of @ref recvmmsg()
+   datasize_t   bufsize;    ///< The byte size of <i>buf</i>
+   wiz_UdpFlow* flows;      ///< The list of flows
+   uint16_t     drops;      ///< The count of datagrams dropped without a flow or larger than <i>buf</i>
+}wiz_UdpMux;
+
 /**
  * @ingroup DATA_TYPE
  * @brief The type of @ref ctlsocket().
@@ -449,7 +589,10 @@ typedef enum
    SO_EXTSTATUS,        ///< Valid only in @ref getsockopt(). Get the extended TCP SOCKETn status. @ref getSn_ESR()
    SO_REMAINSIZE,       ///< Valid only in @ref getsockopt(). Get the remained packet size in non-TCP mode.
    SO_MODE,
-   SO_PACKINFO          ///< Valid only in @ref getsockopt(). Get the packet information as @ref PACK_FIRST, @ref PACK_REMAINED, and etc.
+   SO_PACKINFO,         ///< Valid only in @ref getsockopt(). Get the packet information as @ref PACK_FIRST, @ref PACK_REMAINED, and etc.
+   SO_RECVBATCH,        ///< Set/Get the byte threshold of @ref recv() to commit @ref _Sn_RX_RD_ with @ref Sn_CR_RECV in TCP mode. 0 commits every @ref recv().
+   SO_RECVFLUSH,        ///< Valid only in @ref setsockopt(). Commit @ref _Sn_RX_RD_ of the data read by @ref recv() in TCP mode.
+   SO_SENDPARTIAL       ///< Set/Get the partial write of @ref send() and @ref sendv() in non-block io mode TCP. 1 : enable, 0 : disable
 }sockopt_type;
 
 /**
@@ -496,6 +639,9 @@ int8_t ctlsocket(uint8_t sn, ctlsock_type cstype, void* arg);
  *              <tr> <td> @ref SO_DESTPORT      </td> <td> uint16_t           </td><td> 1 ~ 65535 </td> </tr>
  *              <tr> <td> @ref SO_KEEPALIVESEND </td> <td> null               </td><td> null      </td> </tr> 
  *              <tr> <td> @ref SO_KEEPALIVEAUTO </td> <td> uint8_t            </td><td> 0 ~ 255   </td> </tr> 
+ *              <tr> <td> @ref SO_RECVBATCH     </td> <td> @ref datasize_t    </td><td> 0 ~ @ref getSn_RxMAX() / 2 </td> </tr> 
+ *              <tr> <td> @ref SO_RECVFLUSH     </td> <td> null               </td><td> null      </td> </tr> 
+ *              <tr> <td> @ref SO_SENDPARTIAL   </td> <td> uint8_t            </td><td> 0 or 1    </td> </tr> 
  *           </table>
  * @return 
  *   - Success : @ref SOCK_OK \n
@@ -504,6 +650,10 @@ int8_t ctlsocket(uint8_t sn, ctlsock_type cstype, void* arg);
  *     - @ref SOCKERR_SOCKMODE    - Invalid SOCKET mode \n
  *     - @ref SOCKERR_SOCKOPT     - Invalid SOCKET option or its value \n
  *     - @ref SOCKERR_TIMEOUT     - Timeout occurred when sending keep-alive packet
+ * @note With @ref SO_RECVBATCH, @ref recv() keeps the read position in host memory and commits @ref _Sn_RX_RD_ with @ref Sn_CR_RECV
+ *       only when the uncommitted data reaches the threshold, when @ref recv() has read all the data known to be received, or by @ref SO_RECVFLUSH.\n
+ *       It reduces the commands and the window-update segments of small reads. For example, use @ref getSn_RxMAX() / 4.
+ *       The threshold is limited to @ref getSn_RxMAX() / 2, so that the peer always keeps a window to send.
  */
 int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg);
 
@@ -528,6 +678,8 @@ int8_t setsockopt(uint8_t sn, sockopt_type sotype, void* arg);
  *              <tr> <td> @ref SO_EXTSTATUS     </td> <td> uint8_t            </td><td> @ref TCPSOCK_MODE, @ref TCPSOCK_OP, @ref TCPSOCK_SIP </td></tr>   
  *              <tr> <td> @ref SO_REMAINSIZE    </td> <td> @ref datasize_t    </td><td> 0~                         </td></tr>
  *              <tr> <td> @ref SO_PACKINFO      </td> <td> uint8_t            </td><td> @ref PACK_FIRST, etc.      </td></tr>
+ *              <tr> <td> @ref SO_RECVBATCH     </td> <td> @ref datasize_t    </td><td> 0 ~ @ref getSn_RxMAX() / 2 </td></tr>
+ *              <tr> <td> @ref SO_SENDPARTIAL   </td> <td> uint8_t            </td><td> 0 or 1                     </td></tr>
  *           </table>
  * @return 
  *   - Success : @ref SOCK_OK \n
@@ -546,17 +698,418 @@ int8_t getsockopt(uint8_t sn, sockopt_type sotype, void* arg);
  *  @details It peeks the incoming message of SOCKETn RX buffer. \n
  *           It can find the specified sub-message in the incoming message and
  *           return the length of incoming message before the sub-message. \n
- *           It is useful when you need to read each messages from multiple message in SOCKET RX buffer.
+ *           It is useful when you need to read each messages from multiple message in SOCKET RX buffer. \n
+ *           The incoming message is read by @ref SOCK_PEEK_CHUNK_SIZE bytes at a time,
+ *           and the sub-message is matched by KMP algorithm across the chunks.
  *  @param sn SOCKET number
  *  @param submsg sub-message pointer to find
  *  @param subsize the length of <i>submsg</i>
  * @return
  *   - Success : the length of incoming message length before the <i>submsg</i> \n
- *   - Fail : -1
+ *   - Fail : -1, or <i>subsize</i> is 0 or greater than @ref SOCK_PEEK_SUBMSG_MAX
  * @note
  *   It is just return the length of incoming message before the found sub-message. It does not receive the message.\n
  *   So, after calling peeksockmsg, @ref _Sn_RX_RD_ is not changed.
  */
 int16_t peeksockmsg(uint8_t sn, uint8_t* submsg, uint16_t subsize);
 
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Reserves a space in SOCKETn TX buffer to be written directly.
+ * @details It waits until the free size of SOCKETn TX buffer is greater than or equal to <i>len</i>,\n
+ *          and then reserves <i>len</i> bytes from @ref _Sn_TX_WR_.\n
+ *          The reserved space is filled by @ref wiz_tx_write() and sent by @ref wiz_tx_commit().
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param len The byte length to be reserved.
+ * @return   Success : <i>len</i> \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_DATALEN    - <i>len</i> is zero or greater than SOCKET TX buffer size \n
+ *                          @ref SOCKERR_SOCKCLOSED - SOCKET is closed \n
+ *                          @ref SOCKERR_SOCKSTATUS - Invalid SOCKET status in TCP mode \n
+ *                          @ref SOCK_BUSY          - The free size is not enough in non-block io mode.
+ * @note A new reservation replaces the previous one which is not committed yet.
+ * @sa wiz_tx_write(), wiz_tx_commit()
+ */
+datasize_t wiz_tx_reserve(uint8_t sn, datasize_t len);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Writes data into the reserved space of SOCKETn TX buffer.
+ * @details It copies <i>buf</i> to the offset <i>off</i> of the space reserved by @ref wiz_tx_reserve().\n
+ *          The pieces such as header, payload and trailer can be written in any order.
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param off The offset in the reserved space.
+ * @param buf Pointer of data buffer to be written.
+ * @param len The byte length of data in <i>buf</i>.
+ * @return   Success : <i>len</i> \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_DATALEN    - <i>off</i> + <i>len</i> exceeds the reserved space.
+ * @sa wiz_tx_reserve(), wiz_tx_commit()
+ */
+datasize_t wiz_tx_write(uint8_t sn, datasize_t off, uint8_t * buf, datasize_t len);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Sends the reserved space of SOCKETn TX buffer.
+ * @details It increases @ref _Sn_TX_WR_ as many as the reserved size and sends it with one @ref Sn_CR_SEND.\n
+ *          In TCP mode, it waits for the previous sent data to be completed like @ref send().\n
+ *          In the other mode, it sends to the destination already set in @ref _Sn_DIPR_ or @ref _Sn_DIP6R_ and @ref _Sn_DPORTR_,\n
+ *          and waits for @ref Sn_IR_SENDOK like @ref sendto(). @ref Sn_CR_SEND6 is used in @ref Sn_MR_UDP6 and @ref Sn_MR_IPRAW6,\n
+ *          and in @ref Sn_MR_UDPD when the destination is an IPv6 address set by @ref connect(), @ref sendto() or @ref SO_DESTIP.
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @return   Success : The sent data size \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_DATALEN    - No reserved space \n
+ *                          @ref SOCKERR_SOCKSTATUS - Invalid SOCKET status in TCP mode \n
+ *                          @ref SOCKERR_TIMEOUT    - Timeout occurred \n
+ *                          @ref SOCK_BUSY          - The previous sent data is not completed in non-block io mode. The reservation is kept.
+ * @sa wiz_tx_reserve(), wiz_tx_write()
+ */
+datasize_t wiz_tx_commit(uint8_t sn);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Peeks the received data of SOCKETn RX buffer without consuming it.
+ * @details It copies the received data at the offset <i>off</i> from @ref _Sn_RX_RD_ to <i>buf</i> as many as <i>len</i>.\n
+ *          @ref _Sn_RX_RD_ is not changed. The consumed data is committed by @ref wiz_rx_consume().
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param off The offset from @ref _Sn_RX_RD_.
+ * @param buf Pointer buffer to read the received data.
+ * @param len The max byte length to be read.
+ * @return   Success : The read data size. It is 0 when no data is received at <i>off</i>. \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_DATALEN    - Invalid <i>off</i> or <i>len</i>
+ * @note It does not wait for the received data. \n
+ *       The data is the raw data of SOCKETn RX buffer. In the other mode than TCP, it includes PACKET INFO header.
+ * @sa wiz_rx_consume(), wiz_rx_walk()
+ */
+datasize_t wiz_rx_peek(uint8_t sn, datasize_t off, uint8_t * buf, datasize_t len);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Consumes the received data of SOCKETn RX buffer.
+ * @details It increases @ref _Sn_RX_RD_ as many as <i>len</i> and commits it with one @ref Sn_CR_RECV.
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param len The byte length to be consumed.
+ * @return   Success : <i>len</i> \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_DATALEN    - <i>len</i> is zero or greater than the received data size
+ * @sa wiz_rx_peek(), wiz_rx_walk()
+ */
+datasize_t wiz_rx_consume(uint8_t sn, datasize_t len);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Walks the received data of SOCKETn RX buffer in fixed-size chunks.
+ * @details It reads the received data from @ref _Sn_RX_RD_ into <i>chunk</i> as many as <i>chunksize</i> at a time,\n
+ *          and calls <i>cb</i> with the offset and the length of each chunk, until <i>cb</i> returns non-zero or all data is walked.\n
+ *          @ref _Sn_RX_RD_ is not changed. The parsed data is committed by @ref wiz_rx_consume().
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param chunk Pointer buffer of a chunk.
+ * @param chunksize The byte size of <i>chunk</i>.
+ * @param cb Callback function for each chunk. It returns 0 to continue, or non-zero to stop.
+ * @param arg Argument passed to <i>cb</i>.
+ * @return   Success : The walked data size \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_ARG        - Invalid <i>chunksize</i> or <i>cb</i>
+ * @sa wiz_rx_peek(), wiz_rx_consume()
+ */
+datasize_t wiz_rx_walk(uint8_t sn, uint8_t * chunk, datasize_t chunksize, int8_t (*cb)(uint8_t sn, datasize_t off, uint8_t * chunk, datasize_t len, void * arg), void * arg);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Waits for events on SOCKETs.
+ * @details It reads @ref _SIR_ once per sweep and touches only the SOCKETs whose bit is set in @ref _SIR_,
+ *          whose @ref Sn_IR_SENDOK or @ref Sn_IR_TIMEOUT is latched by @ref wiz_sock_isr(),
+ *          or whose state is changed by the SOCKET APIs since the last sweep.\n
+ *          For such a SOCKET, it takes all the bits of @ref _Sn_IR_ with one @ref _Sn_IRCLR_ write
+ *          and reads the state with @ref _Sn_SR_, @ref _Sn_RX_RSR_ and @ref _Sn_TX_FSR_ into host memory.
+ *          The other SOCKETs are reported from the state kept in host memory without any access.\n
+ *          - @ref SIK_CONNECTED : @ref _Sn_SR_ is @ref SOCK_ESTABLISHED, or the connection is established. \n
+ *          - @ref SIK_DISCONNECTED : @ref _Sn_SR_ is @ref SOCK_CLOSE_WAIT or @ref SOCK_CLOSED, or the peer requests to disconnect. \n
+ *          - @ref SIK_RECEIVED : The received data is left to read. \n
+ *          - @ref SIK_TIMEOUT : ARP or TCP timeout occurred. \n
+ *          - @ref SIK_SENT : No data is being sent and SOCKETn TX buffer has free space. It can be sent without waiting.
+ * @param fds Array of @ref wiz_PollFd. Each SOCKET should appear once.
+ * @param nfds The count of <i>fds</i>.
+ * @param timeout The max time to wait in milliseconds. 0 : Sweep once, negative : Wait forever.
+ * @return   Success : The count of <i>fds</i> with non-zero <i>revents</i>. 0 on timeout. \n
+ *           Fail    : \n @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_ARG        - <i>fds</i> is null
+ * @note @ref SIK_CONNECTED, @ref SIK_DISCONNECTED, @ref SIK_RECEIVED and @ref SIK_SENT are level-triggered. 
+ *       They are returned on every call while the state lasts.\n
+ *       @ref SIK_TIMEOUT is returned only once per occurrence.\n
+ *       The state changed by the peer is noticed through @ref _SIR_, so enable all the SOCKET interrupts in @ref _Sn_IMR_.\n
+ *       <i>timeout</i> is measured with @ref _TCNTR_.
+ */
+int16_t wiz_poll(wiz_PollFd* fds, uint8_t nfds, int32_t timeout);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Send the data segments to the connected peer.
+ * @details It is same as @ref send() except that the data is gathered from <i>iov</i>.\n
+ *          The total length is checked with @ref _Sn_TX_FSR_ once, and each segment is written consecutively into SOCKETn TX buffer.
+ *          Then @ref _Sn_TX_WR_ is updated once and one @ref Sn_CR_SEND is issued.
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param iov Array of @ref wiz_IoVec
+ * @param iovcnt The count of <i>iov</i>
+ * @return   Success : The real sent data size. It may be equal to the total length of <i>iov</i> or small. \n
+ *           Fail    : \n @ref SOCKERR_SOCKSTATUS - Invalid SOCKET status for SOCKET operation \n
+ *                          @ref SOCKERR_SOCKMODE   - Invalid operation in the SOCKET \n
+ *                          @ref SOCKERR_SOCKNUM    - Invalid SOCKET number \n
+ *                          @ref SOCKERR_ARG        - <i>iov</i> is null or <i>iovcnt</i> is 0 \n
+ *                          @ref SOCKERR_DATALEN    - The total length is 0 \n
+ *                          @ref SOCK_BUSY          - SOCKET is busy.
+ * @note It is valid only in TCP mode such as @ref Sn_MR_TCP4, Sn_MR_TCP6, and Sn_MR_TCPD.\n
+ *       When the total length is greater than SOCKET TX buffer size, the segments are sent as many as SOCKET TX buffer size.
+ * @sa send()
+ */
+datasize_t sendv(uint8_t sn, const wiz_IoVec * iov, uint8_t iovcnt);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Receives datagrams from peers at once.
+ * @details It reads the received data of SOCKETn RX buffer into <i>buf</i> with a burst read as many as @ref _Sn_RX_RSR_ or <i>bufsize</i>,
+ *          and parses the PACKET INFO of each datagram into <i>msgs</i>.\n
+ *          Only the completely read datagrams are released by one @ref Sn_CR_RECV.
+ *          A datagram cut by <i>bufsize</i> remains for the next call.
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param buf Buffer to save the received datagrams including PACKET INFO
+ * @param bufsize The byte size of <i>buf</i>
+ * @param msgs Array of @ref wiz_MMsg. The data of each one points into <i>buf</i>.
+ * @param vlen The count of <i>msgs</i>
+ * @return   Success : The count of received datagrams \n
+ *           Fail    : @ref SOCKERR_SOCKMODE   - Invalid operation in the socket \n
+ *                     @ref SOCKERR_SOCKNUM    - Invalid socket number \n
+ *                     @ref SOCKERR_SOCKSTATUS - The remained data of the previous datagram should be read by @ref recvfrom(). \n
+ *                     @ref SOCKERR_ARG        - Invalid parameter \n
+ *                     @ref SOCKERR_BUFFER     - The first datagram is larger than <i>bufsize</i>. Read it by @ref recvfrom(). \n
+ *                     @ref SOCKERR_SOCKCLOSED - SOCKET closed \n
+ *                     @ref SOCKFATAL_PACKLEN  - Invalid packet length in @ref Sn_MR_MACRAW \n
+ *                     @ref SOCK_BUSY          - No datagram in non-block io mode
+ * @note It is valid only in @ref Sn_MR_UDP4, @ref Sn_MR_UDP6, @ref Sn_MR_UDPD, @ref Sn_MR_IPRAW4, @ref Sn_MR_IPRAW6, and @ref Sn_MR_MACRAW.\n
+ *       <i>buf</i> is overwritten by the next call. Process <i>msgs</i> before it.
+ * @sa recvfrom()
+ */
+int16_t recvmmsg(uint8_t sn, uint8_t * buf, datasize_t bufsize, wiz_MMsg * msgs, uint8_t vlen);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Sends datagrams to peers at once.
+ * @details It pipelines the datagrams of <i>msgs</i>. The data of the next datagram is written into SOCKETn TX buffer
+ *          while the previous datagram is being sent, and then @ref Sn_IR_SENDOK of the previous one is checked.\n
+ *          The destination registers are written only when they differ from the previous datagram.\n
+ *          It doesn't wait for @ref Sn_IR_SENDOK of the last datagram. It is checked by the next @ref sendmmsg() or @ref sendto().
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param msgs Array of @ref wiz_MMsg. <i>buf</i>, <i>len</i>, <i>addr</i>, <i>addrlen</i> and <i>port</i> are used.
+ * @param vlen The count of <i>msgs</i>
+ * @return   Success : The count of datagrams passed to SOCKETn. The rest of <i>msgs</i> should be sent again. \n
+ *           Fail    : @ref SOCKERR_SOCKMODE   - Invalid operation in the socket \n
+ *                     @ref SOCKERR_SOCKNUM    - Invalid socket number \n
+ *                     @ref SOCKERR_ARG        - Invalid parameter \n
+ *                     @ref SOCKERR_DATALEN    - The data length is 0 or greater than SOCKETn TX buffer \n
+ *                     @ref SOCKERR_IPINVALID  - Invalid <i>addrlen</i> \n
+ *                     @ref SOCKERR_PORTZERO   - <i>port</i> is 0 \n
+ *                     @ref SOCKERR_SOCKCLOSED - SOCKET closed \n
+ *                     @ref SOCKERR_TIMEOUT    - The previous datagram is timed out \n
+ *                     @ref SOCK_BUSY          - No space or the previous datagram is being sent in non-block io mode
+ * @note It is valid only in @ref Sn_MR_UDP4, @ref Sn_MR_UDP6, @ref Sn_MR_UDPD, @ref Sn_MR_IPRAW4, @ref Sn_MR_IPRAW6, and @ref Sn_MR_MACRAW.\n
+ *       If an error occurs after some datagrams are passed, the count of them is returned.
+ * @sa sendto()
+ */
+int16_t sendmmsg(uint8_t sn, wiz_MMsg * msgs, uint8_t vlen);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Enables the interrupts consumed by @ref wiz_sock_isr().
+ * @details It sets @ref _IMR_, @ref _SIMR_, @ref _SLIMR_ with <i>intr</i>, @ref _Sn_IMR_ of the SOCKETs in <i>intr</i> with <i>sockint</i>,
+ *          and @ref _INTPTMR_ with <i>intptime</i>. Then it empties the event queue and sets @ref SYCR1_IEN.\n
+ *          @ref _INTPTMR_ pends the next INTn assertion while the interrupts are being handled,
+ *          so the events of the SOCKETs are coalesced into one INTn under load.
+ *          Use @ref CW_SET_INTRMOD to tune @ref _INTPTMR_ by the event rate.
+ * @param intr The operated OR value of @ref intr_kind
+ * @param sockint The operated OR value of @ref sockint_kind
+ * @param intptime The value of @ref _INTPTMR_. It is decreased 1 every 4 SYS_CLK. 0 means no coalescing.
+ * @return @ref SOCK_OK
+ * @note @ref ctlnetservice() waits for @ref _SLIR_. Don't enable @ref IK_SOCKL_ALL while it is used.\n
+ *       Use @ref wiz_sock_event_get() instead of @ref wiz_poll() after it.
+ * @sa wiz_sock_isr(), wiz_sock_event_get(), CW_SET_INTRTIME
+ */
+int8_t wiz_sock_event_init(intr_kind intr, uint8_t sockint, uint16_t intptime);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Handles the interrupt of INTn pin.
+ * @details Call it in the ISR of INTn pin. It reads @ref _IR_, @ref _SIR_ and @ref _SLIR_ with a burst read,
+ *          and reads @ref _Sn_IR_ only of the SOCKETs whose bit is set in @ref _SIR_.\n
+ *          The read bits are cleared and queued as @ref wiz_SockEvent, one event per register.
+ *          If the queue is full, the event is lost and counted by @ref wiz_sock_event_lost().\n
+ *          @ref SIK_SENT and @ref SIK_TIMEOUT are also kept for @ref send(), @ref sendto(), @ref connect() and so on,
+ *          so they don't wait forever.
+ * @note The SPI or BUS access of it should not be interrupted. @ref reg_wizchip_cris_cbfunc() should disable INTn interrupt.
+ * @sa wiz_sock_event_init(), wiz_sock_event_get(), wizchip_intrmod_update()
+ */
+void wiz_sock_isr(void);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Gets an event queued by @ref wiz_sock_isr().
+ * @param ev The event
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCK_BUSY - No event
+ * @note Only one context should call it. It doesn't access @ref _WIZCHIP_.
+ */
+int8_t wiz_sock_event_get(wiz_SockEvent* ev);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Gets and clears the count of events lost by the full queue.
+ * @return The count of lost events
+ * @note If it is not 0, use @ref wizchip_getinterrupt() or @ref getsockopt() to find the missed state.
+ */
+uint16_t wiz_sock_event_lost(void);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Opens a pool of <b>TCP SERVER</b> SOCKETs listening to the same port.
+ * @details Each SOCKET in @ref SOCK_LISTEN accepts only one connection.
+ *          All SOCKETs in <i>sockmask</i> are opened by @ref socket() and listen by @ref listen(), 
+ *          so the connection requests up to the count of them are accepted at the same time.\n
+ *          The established SOCKETs are handed to the application by @ref wiz_accept(), and the closed SOCKETs are listening again.
+ * @param pool The listener pool
+ * @param protocol @ref Sn_MR_TCP4, @ref Sn_MR_TCP6, or @ref Sn_MR_TCPD
+ * @param port The listen port number
+ * @param flag The SOCKET flag passed to @ref socket()
+ * @param sockmask The SOCKETs of the pool. Bit n is SOCKETn.
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCKERR_ARG        - Invalid parameter \n
+ *                     @ref SOCKERR_PORTZERO   - <i>port</i> is 0 \n
+ *                     @ref SOCKERR_SOCKMODE   - <i>protocol</i> is not TCP \n
+ *                     The error of @ref socket() or @ref listen(). The SOCKETs opened by it are closed.
+ * @sa wiz_accept(), wiz_listen_pool_close()
+ */
+int8_t wiz_listen_pool(wiz_ListenPool* pool, uint8_t protocol, uint16_t port, uint8_t flag, uint16_t sockmask);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Hands an established SOCKET of the listener pool to the application.
+ * @details It checks @ref _Sn_SR_ of the SOCKETs in the pool. 
+ *          A SOCKET in @ref SOCK_ESTABLISHED or @ref SOCK_CLOSE_WAIT is handed out once, in turn from the SOCKET after the last one handed out.\n
+ *          A closed SOCKET is opened and listens again immediately, including the SOCKET closed by the application after it is handed out. 
+ *          So the application just closes the SOCKET by @ref disconnect() or @ref close() when the session is done.
+ * @param pool The listener pool opened by @ref wiz_listen_pool()
+ * @param sn The SOCKET number of the established connection
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCK_BUSY - No new connection
+ * @note It doesn't block. Call it periodically so that the closed SOCKETs listen again.
+ * @sa wiz_listen_pool(), wiz_listen_pool_close()
+ */
+int8_t wiz_accept(wiz_ListenPool* pool, uint8_t* sn);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Closes the listener pool.
+ * @details The SOCKETs not handed out are closed. The SOCKETs handed out by @ref wiz_accept() are left to the application.
+ * @param pool The listener pool
+ * @return @ref SOCK_OK
+ * @sa wiz_listen_pool()
+ */
+int8_t wiz_listen_pool_close(wiz_ListenPool* pool);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Opens a UDP flow multiplexer.
+ * @details It opens SOCKET <i>sn</i> in @ref Sn_MR_UDPD and non-block io mode. 
+ *          The datagrams of IPv4 and IPv6 peers are received by @ref wiz_udpmux_poll() and routed to @ref wiz_UdpFlow by the remote address and port.
+ * @param mux The multiplexer
+ * @param sn SOCKET number. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param port The local port number
+ * @param flag The SOCKET flag passed to @ref socket(). The io mode is always @ref SOCK_IO_NONBLOCK.
+ * @param buf The buffer to read datagrams with PACKET INFO. It should be larger than the largest datagram plus 20 bytes.
+ * @param bufsize The byte size of <i>buf</i>
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCKERR_ARG - Invalid parameter \n
+ *                     The error of @ref socket().
+ * @sa wiz_udpflow_add(), wiz_udpmux_poll(), wiz_udpmux_close()
+ */
+int8_t wiz_udpmux_open(wiz_UdpMux* mux, uint8_t sn, uint16_t port, uint8_t flag, uint8_t* buf, datasize_t bufsize);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Closes the SOCKET of the UDP flow multiplexer. The flows are removed.
+ * @param mux The multiplexer
+ * @return @ref SOCK_OK
+ */
+int8_t wiz_udpmux_close(wiz_UdpMux* mux);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Adds a logical UDP flow to the multiplexer.
+ * @param mux The multiplexer
+ * @param flow The flow to be added
+ * @param addr The remote IP address
+ * @param addrlen 4 or 16. 0 makes the flow receive the datagrams of all the peers without their own flow.
+ * @param port The remote port number
+ * @param qbuf The queue memory of the flow. Each datagram uses its length plus 2 bytes, and plus 3 + its address length if <i>addrlen</i> is 0.
+ * @param qsize The byte size of <i>qbuf</i>
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCKERR_ARG       - Invalid parameter or the flow of the same peer exists \n
+ *                     @ref SOCKERR_IPINVALID - Invalid <i>addrlen</i> \n
+ *                     @ref SOCKERR_PORTZERO  - <i>port</i> is 0
+ * @sa wiz_udpflow_remove()
+ */
+int8_t wiz_udpflow_add(wiz_UdpMux* mux, wiz_UdpFlow* flow, uint8_t* addr, uint8_t addrlen, uint16_t port, uint8_t* qbuf, datasize_t qsize);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Removes a logical UDP flow from the multiplexer. The queued datagrams are discarded.
+ * @param mux The multiplexer
+ * @param flow The flow to be removed
+ * @return   Success : @ref SOCK_OK \n
+ *           Fail    : @ref SOCKERR_ARG - The flow is not in the multiplexer
+ */
+int8_t wiz_udpflow_remove(wiz_UdpMux* mux, wiz_UdpFlow* flow);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Routes the received datagrams to the queues of the flows.
+ * @details It reads the datagrams by @ref recvmmsg() until SOCKETn RX buffer is empty, and queues each one to the flow of its source.
+ *          A datagram without a flow, or larger than the buffer of @ref wiz_udpmux_open(), is dropped and counted in <i>drops</i> of @ref wiz_UdpMux.
+ *          A datagram not fitting the queue is dropped and counted in <i>drops</i> of @ref wiz_UdpFlow.
+ * @param mux The multiplexer
+ * @return   Success : The count of queued datagrams \n
+ *           Fail    : The error of @ref recvmmsg()
+ * @note It doesn't block. Call it periodically or when @ref SIK_RECEIVED occurs.
+ */
+int16_t wiz_udpmux_poll(wiz_UdpMux* mux);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Receives a datagram from the queue of the flow.
+ * @param flow The flow
+ * @param buf Buffer to save the datagram
+ * @param len The byte size of <i>buf</i>. The rest of a larger datagram is discarded.
+ * @param addr The source IP address. It can be NULL.
+ * @param port The source port number. It can be NULL.
+ * @param addrlen The length of <i>addr</i>. It can be NULL.
+ * @return   Success : The byte length saved in <i>buf</i> \n
+ *           Fail    : @ref SOCK_BUSY - No queued datagram
+ * @note It doesn't access @ref _WIZCHIP_.
+ */
+datasize_t wiz_udpflow_recv(wiz_UdpFlow* flow, uint8_t* buf, datasize_t len, uint8_t* addr, uint16_t* port, uint8_t* addrlen);
+
+/**
+ * @ingroup WIZnet_socket_APIs
+ * @brief Sends a datagram to the peer of the flow.
+ * @details It calls @ref sendto() with the address and port of the flow. 
+ *          The destination registers are not written again while the same flow is sending.
+ * @param flow The flow
+ * @param buf Pointer of data buffer to be sent
+ * @param len The byte length of data in <i>buf</i>
+ * @return   Success : The sent data size \n
+ *           Fail    : @ref SOCKERR_IPINVALID - The flow receives all the peers \n
+ *                     The error of @ref sendto(). @ref SOCK_BUSY if SOCKET TX buffer is not enough.
+ */
+datasize_t wiz_udpflow_send(wiz_UdpFlow* flow, uint8_t* buf, datasize_t len);
+
 #endif   // _SOCKET_H_
@@ -107,12 +107,37 @@ void wizchip_bus_write(uint32_t AddrSel, iodata_t wb)  { *((volatile iodata_t*)(
  *        0 : Not Increased \n
  *        1 : Increased
  * @return void
- * @note It can be overwritten with your function or register your functions by calling @ref reg_wizchip_bus_cbfunc().
+ * @note It can be overwritten with your function or register your functions by calling @ref reg_wizchip_bus_cbfunc().\n
+ *       When @ref wizchip_bus_read() is used, it reads the memory-mapped address directly, unrolled by 4 accesses.
  * @sa wizchip_bus_write_buf()
  */
 void wizchip_bus_read_buf(uint32_t AddrSel, iodata_t* buf, datasize_t len, uint8_t addrinc)
 { 
    datasize_t i;
+   volatile iodata_t* pAddr;
+   if(WIZCHIP.IF.BUS._read_data == wizchip_bus_read)
+   {
+      pAddr = (volatile iodata_t*)((ptrdiff_t)AddrSel);
+      if(addrinc)
+      {
+         for( ; len >= 4; len -= 4, buf += 4, pAddr += 4)
+         {
+            buf[0] = pAddr[0];  buf[1] = pAddr[1];
+            buf[2] = pAddr[2];  buf[3] = pAddr[3];
+         }
+         for( ; len > 0; len--) *buf++ = *pAddr++;
+      }
+      else
+      {
+         for( ; len >= 4; len -= 4, buf += 4)
+         {
+            buf[0] = *pAddr;  buf[1] = *pAddr;
+            buf[2] = *pAddr;  buf[3] = *pAddr;
+         }
+         for( ; len > 0; len--) *buf++ = *pAddr;
+      }
+      return;
+   }
    if(addrinc) addrinc = sizeof(iodata_t);
    for ( i = 0; i < len; i++)
    {
@@ -131,12 +156,37 @@ void wizchip_bus_read_buf(uint32_t AddrSel, iodata_t* buf, datasize_t len, uint8
  *        0 : Not Increased \n
  *        1 : Increased
  * @return void
- * @note It can be overwritten with your function or register your functions by calling @ref reg_wizchip_bus_cbfunc().
+ * @note It can be overwritten with your function or register your functions by calling @ref reg_wizchip_bus_cbfunc().\n
+ *       When @ref wizchip_bus_write() is used, it writes the memory-mapped address directly, unrolled by 4 accesses.
  * @sa wizchip_bus_read_buf()
  */
 void wizchip_bus_write_buf(uint32_t AddrSel, iodata_t* buf, datasize_t len, uint8_t addrinc)
 { 
    datasize_t i;
+   volatile iodata_t* pAddr;
+   if(WIZCHIP.IF.BUS._write_data == wizchip_bus_write)
+   {
+      pAddr = (volatile iodata_t*)((ptrdiff_t)AddrSel);
+      if(addrinc)
+      {
+         for( ; len >= 4; len -= 4, buf += 4, pAddr += 4)
+         {
+            pAddr[0] = buf[0];  pAddr[1] = buf[1];
+            pAddr[2] = buf[2];  pAddr[3] = buf[3];
+         }
+         for( ; len > 0; len--) *pAddr++ = *buf++;
+      }
+      else
+      {
+         for( ; len >= 4; len -= 4, buf += 4)
+         {
+            *pAddr = buf[0];  *pAddr = buf[1];
+            *pAddr = buf[2];  *pAddr = buf[3];
+         }
+         for( ; len > 0; len--) *pAddr = *buf++;
+      }
+      return;
+   }
    if(addrinc) addrinc = sizeof(iodata_t);
    for( i = 0; i < len ; i++)
    {
@@ -232,7 +282,7 @@ _WIZCHIP_T_  WIZCHIP =
          wizchip_bus_read_buf,
          wizchip_bus_write_buf
       }
-   }
+   },
 #elif (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
    {
       .SPI =
@@ -242,10 +292,15 @@ _WIZCHIP_T_  WIZCHIP =
          wizchip_spi_read_buf,
          wizchip_spi_write_buf
       }
-   }
+   },
 #else
    #error "Undefined _WIZCHIP_IO_MODE_. You should define it"   
 #endif
+   0,                // _xfer_v : WIZCHIP_XFER_V() runs the descriptors one by one.
+   {
+      0,             // ASYNC : The asynchronous data functions run synchronously.
+      0
+   }
 };
 
 
@@ -269,6 +324,11 @@ void reg_wizchip_cs_cbfunc(void(*cs_sel)(void), void(*cs_desel)(void))
    else           WIZCHIP.CS._d_e_s_e_l_e_c_t_ = cs_desel;
 }
 
+void reg_wizchip_xfer_cbfunc(void (*xfer_v)(wiz_XferDesc* xfer, uint8_t cnt))
+{
+   WIZCHIP._xfer_v = xfer_v;
+}
+
 #if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_BUS_)
 void reg_wizchip_bus_cbfunc( iodata_t(*bus_rd)(uint32_t addr), 
                              void (*bus_wd)(uint32_t addr, iodata_t wb),
@@ -308,6 +368,15 @@ void reg_wizchip_spi_cbfunc( uint8_t (*spi_rb)(void),
    if(!spi_wbuf)  WIZCHIP.IF.SPI._write_byte_buf = wizchip_spi_write_buf;
    else           WIZCHIP.IF.SPI._write_byte_buf = spi_wbuf;
 }
+
+void reg_wizchip_spi_async_cbfunc(void (*spi_rbuf)(uint8_t* buf, datasize_t len),
+                                  void (*spi_wbuf)(uint8_t* buf, datasize_t len) )
+{
+   while(!(WIZCHIP.if_mode & _WIZCHIP_IO_MODE_SPI_));
+
+   WIZCHIP.ASYNC._read_byte_buf  = spi_rbuf;
+   WIZCHIP.ASYNC._write_byte_buf = spi_wbuf;
+}
 #endif
 
 int8_t ctlwizchip(ctlwizchip_type cwtype, void* arg)
@@ -358,6 +427,12 @@ int8_t ctlwizchip(ctlwizchip_type cwtype, void* arg)
       case CW_GET_INTRTIME:
          *(uint16_t*)arg = getINTPTMR();
          break;   
+      case CW_SET_INTRMOD:
+         wizchip_setintrmod((wiz_IntrMod*)arg);
+         break;
+      case CW_GET_INTRMOD:
+         wizchip_getintrmod((wiz_IntrModStat*)arg);
+         break;
       case CW_SET_IEN:
          tmp = getSYCR1();
          if(*(uint8_t*)arg == 1) setSYCR1(tmp | SYCR1_IEN);
@@ -561,6 +636,212 @@ intr_kind wizchip_getinterruptmask(void)
    return (intr_kind)ret;
 }
 
+static wiz_IntrMod     intrmod = {0,};
+static wiz_IntrModStat intrmod_stat = {0,};
+static volatile uint16_t intrmod_ms = 0;       // elapsed time of the current interval
+static uint16_t intrmod_intr = 0;              // interrupts of the current interval
+static uint32_t intrmod_event = 0;             // events of the current interval
+
+void wizchip_setintrmod(wiz_IntrMod* pintrmod)
+{
+   wiz_IntrModStat zero = {0,};
+   intrmod = *pintrmod;
+   if(intrmod.max_time < intrmod.min_time) intrmod.max_time = intrmod.min_time;
+   if(intrmod.high_rate <= intrmod.low_rate) intrmod.high_rate = intrmod.low_rate + 1;
+   intrmod_stat = zero;
+   intrmod_stat.intptime = intrmod.min_time;
+   intrmod_ms = intrmod_intr = 0;
+   intrmod_event = 0;
+   setINTPTMR(intrmod.min_time);
+}
+
+void wizchip_getintrmod(wiz_IntrModStat* stat)
+{
+   *stat = intrmod_stat;
+}
+
+void wizchip_intrmod_time_handler(void)
+{
+   if(intrmod_ms < 0xFFFF) intrmod_ms++;
+}
+
+void wizchip_intrmod_update(uint8_t events)
+{
+   uint16_t ms;
+   uint32_t ptime;
+   intrmod_stat.intr_cnt++;
+   if(intrmod.interval == 0) return;
+   intrmod_intr++;
+   intrmod_event += events;
+   ms = intrmod_ms;
+   if(ms < intrmod.interval) return;
+   intrmod_ms = 0;
+   intrmod_stat.intr_rate  = ((uint32_t)intrmod_intr * 1000) / ms;
+   intrmod_stat.event_rate = (intrmod_event * 1000) / ms;
+   intrmod_intr  = 0;
+   intrmod_event = 0;
+   if(intrmod_stat.event_rate <= intrmod.low_rate)       ptime = intrmod.min_time;
+   else if(intrmod_stat.event_rate >= intrmod.high_rate) ptime = intrmod.max_time;
+   else ptime = intrmod.min_time + ((uint32_t)(intrmod.max_time - intrmod.min_time) * (intrmod_stat.event_rate - intrmod.low_rate)) / (intrmod.high_rate - intrmod.low_rate);
+   if(ptime != intrmod_stat.intptime)
+   {
+      setINTPTMR((uint16_t)ptime);
+      intrmod_stat.intptime = (uint16_t)ptime;
+      intrmod_stat.tune_cnt++;
+   }
+}
+
+#define BUFMGR_TOTAL    (2*_WIZCHIP_SOCK_NUM_)    // the size of TX or RX memory (unit KB)
+
+static wiz_BufPolicy bufmgr_policy = 0;
+static wiz_BufDemand bufmgr_demand[_WIZCHIP_SOCK_NUM_] = {{0,},};
+
+void wizchip_bufmgr_init(wiz_BufPolicy policy)
+{
+   uint8_t i;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      bufmgr_demand[i].tx_hwm = 0;
+      bufmgr_demand[i].rx_hwm = 0;
+   }
+   bufmgr_policy = policy;
+}
+
+uint8_t wizchip_bufmgr_active(void)
+{
+   return (bufmgr_policy != 0);
+}
+
+void wizchip_bufmgr_setmin(uint8_t sn, uint8_t txmin, uint8_t rxmin)
+{
+   if(sn >= _WIZCHIP_SOCK_NUM_) return;
+   bufmgr_demand[sn].tx_min = txmin;
+   bufmgr_demand[sn].rx_min = rxmin;
+}
+
+void wizchip_bufmgr_sample(uint8_t sn)
+{
+   datasize_t used;
+   if(sn >= _WIZCHIP_SOCK_NUM_) return;
+   used = getSn_RX_RSR(sn);
+   if(used > bufmgr_demand[sn].rx_hwm) bufmgr_demand[sn].rx_hwm = used;
+   used = getSn_TxMAX(sn) - getSn_TX_FSR(sn);
+   if(used > bufmgr_demand[sn].tx_hwm) bufmgr_demand[sn].tx_hwm = used;
+}
+
+void wizchip_bufmgr_getdemand(uint8_t sn, wiz_BufDemand* demand)
+{
+   if(sn >= _WIZCHIP_SOCK_NUM_) return;
+   *demand = bufmgr_demand[sn];
+}
+
+/* Round up the buffer size to 0, 1, 2, 4, 8, or 16KB */
+static uint8_t bufmgr_roundup(uint8_t size)
+{
+   uint8_t r = 1;
+   if(size == 0) return 0;
+   while((r < size) && (r < 16)) r <<= 1;
+   return r;
+}
+
+/* Fit the wanted sizes of SOCKET first ~ SOCKET(_WIZCHIP_SOCK_NUM_ -1) to the rest of memory */
+static void bufmgr_fit(uint8_t* size, uint8_t* want, uint8_t* min, uint8_t first)
+{
+   uint8_t k, m, d;
+   int16_t budget = BUFMGR_TOTAL, sum = 0;
+   for(k = 0; k < first; k++) budget -= size[k];
+   if(budget < 0) budget = 0;   // The kept SOCKETs already use more than the memory.
+   for(k = first; k < _WIZCHIP_SOCK_NUM_; k++)
+   {
+      size[k] = bufmgr_roundup(want[k]);
+      sum += size[k];
+   }
+   while(sum > budget)        // halve the largest one, above its minimum first.
+   {
+      m = _WIZCHIP_SOCK_NUM_;
+      for(k = first; k < _WIZCHIP_SOCK_NUM_; k++)
+         if((size[k] > min[k]) && ((m == _WIZCHIP_SOCK_NUM_) || (size[k] > size[m]))) m = k;
+      if(m == _WIZCHIP_SOCK_NUM_)
+         for(k = m = first; k < _WIZCHIP_SOCK_NUM_; k++) if(size[k] > size[m]) m = k;
+      d = (size[m] + 1) >> 1;
+      size[m] -= d;
+      sum -= d;
+   }
+   while(sum < budget)        // give the rest to the most unmet one that fits.
+   {
+      m = _WIZCHIP_SOCK_NUM_;
+      for(k = first; k < _WIZCHIP_SOCK_NUM_; k++)
+      {
+         d = size[k] ? size[k] : 1;
+         if((size[k] < 16) && (d <= budget - sum) &&
+            ((m == _WIZCHIP_SOCK_NUM_) || (((int16_t)want[k] - size[k]) > ((int16_t)want[m] - size[m])))) m = k;
+      }
+      if(m == _WIZCHIP_SOCK_NUM_) break;
+      d = size[m] ? size[m] : 1;
+      size[m] += d;
+      sum += d;
+   }
+}
+
+int8_t wizchip_bufmgr_rebalance(void)
+{
+   uint8_t i, first = 0;
+   uint8_t tx[_WIZCHIP_SOCK_NUM_], rx[_WIZCHIP_SOCK_NUM_];
+   uint8_t txwant[_WIZCHIP_SOCK_NUM_], rxwant[_WIZCHIP_SOCK_NUM_];
+   uint8_t txmin[_WIZCHIP_SOCK_NUM_], rxmin[_WIZCHIP_SOCK_NUM_];
+   if(!bufmgr_policy) return -1;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      if(getSn_SR(i) != SOCK_CLOSED) first = i + 1;
+      tx[i] = getSn_TXBUF_SIZE(i);
+      rx[i] = getSn_RXBUF_SIZE(i);
+      txmin[i] = bufmgr_roundup(bufmgr_demand[i].tx_min);
+      rxmin[i] = bufmgr_roundup(bufmgr_demand[i].rx_min);
+   }
+   /*
+    * The buffers are allocated sequentially from SOCKET0.
+    * Resizing a SOCKET moves the buffers of all the next SOCKETs,
+    * so only the SOCKETs after the last open SOCKET are resized.
+    */
+   if(first < _WIZCHIP_SOCK_NUM_)
+   {
+      bufmgr_policy(bufmgr_demand, txwant, rxwant);
+      bufmgr_fit(tx, txwant, txmin, first);
+      bufmgr_fit(rx, rxwant, rxmin, first);
+      for(i = first; i < _WIZCHIP_SOCK_NUM_; i++)
+      {
+         if(tx[i] != getSn_TXBUF_SIZE(i)) setSn_TXBUF_SIZE(i, tx[i]);
+         if(rx[i] != getSn_RXBUF_SIZE(i)) setSn_RXBUF_SIZE(i, rx[i]);
+      }
+   }
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      bufmgr_demand[i].tx_hwm >>= 1;
+      bufmgr_demand[i].rx_hwm >>= 1;
+   }
+   return 0;
+}
+
+void wizchip_bufpolicy_demand(wiz_BufDemand* demand, uint8_t* txsize, uint8_t* rxsize)
+{
+   uint8_t  i;
+   uint32_t txsum = 0, rxsum = 0;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      txsum += demand[i].tx_hwm;
+      rxsum += demand[i].rx_hwm;
+   }
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++)
+   {
+      txsize[i] = txsum ? (uint8_t)(((uint32_t)demand[i].tx_hwm * BUFMGR_TOTAL + txsum - 1) / txsum) : 2;
+      rxsize[i] = rxsum ? (uint8_t)(((uint32_t)demand[i].rx_hwm * BUFMGR_TOTAL + rxsum - 1) / rxsum) : 2;
+      if(txsize[i] < 1) txsize[i] = 1;
+      if(rxsize[i] < 1) rxsize[i] = 1;
+      if(txsize[i] < demand[i].tx_min) txsize[i] = demand[i].tx_min;
+      if(rxsize[i] < demand[i].rx_min) rxsize[i] = demand[i].rx_min;
+   }
+}
+
 int8_t wizphy_getphylink(void)
 {
 #if (_PHY_IO_MODE_ == _PHY_IO_MODE_PHYCR_)
@@ -79,7 +79,9 @@ extern "C" {
 #define _WIZCHIP_IO_MODE_SPI_VDM_      (_WIZCHIP_IO_MODE_SPI_ + 1) ///< SPI interface mode for variable length data.\n Refer to @ref _WIZCHIP_IO_MODE_SPI_
 /**
  * @brief SPI interface mode for fixed length data mode.
- * @note If you want to use SPI FDM, Feel free to send a email to support@wiznet.io.
+ * @details Each SPI frame has fixed data length of 1, 2 or 4 bytes, so /SCS can be tied to low.\n
+ *          A buffer access is split into 4-byte frames as many as possible, and the rest into 2-byte and 1-byte frames.
+ * @note @ref reg_wizchip_xfer_cbfunc() and @ref reg_wizchip_spi_async_cbfunc() are not used in SPI FDM.
  * @sa _WIZCHIP_IO_MODE_SPI_
  */
 #define _WIZCHIP_IO_MODE_SPI_FDM_      (_WIZCHIP_IO_MODE_SPI_ + 2) 
@@ -111,6 +113,30 @@ extern "C" {
  */
 #define _PHY_IO_MODE_                  _PHY_IO_MODE_PHYCR_ //_PHY_IO_MODE_MII_
 
+/**
+ * @brief Enable the shadow registers in HOST memory.
+ * @details If @ref _WIZCHIP_SHADOW_REG_ is 1, the registers which only HOST writes are kept in @ref WIZCHIP_SHADOW\n
+ *          and their get functions don't access to @ref _WIZCHIP_ again after the first access.\n
+ *          The shadow registers are @ref _SHAR_, @ref _SIPR_, @ref _LLAR_, @ref _GUAR_,\n
+ *          @ref _Sn_MR_, @ref _Sn_MR2_, @ref _Sn_TX_BSR_, @ref _Sn_RX_BSR_, @ref _Sn_PORTR_, @ref _Sn_DIPR_ and @ref _Sn_DPORTR_.
+ * @note You should change them only through their set functions. \n
+ *       If @ref _WIZCHIP_ is reset by hardware, You should call @ref wiz_shadow_clear() or @ref wizchip_init().
+ * @todo Define it to 1 if you want to reduce the count of HOST interface access.
+ * @sa wiz_shadow_read(), wiz_shadow_clear()
+ */
+#define _WIZCHIP_SHADOW_REG_           0
+
+/**
+ * @brief Call the HOST interface functions of wizchip_port.h directly.
+ * @details If @ref _WIZCHIP_PORT_STATIC_ is 1, @ref WIZCHIP_READ(), @ref WIZCHIP_WRITE(), @ref WIZCHIP_READ_BUF() and @ref WIZCHIP_WRITE_BUF()\n
+ *          call the static inline functions of wizchip_port.h instead of the callback functions of @ref WIZCHIP,\n
+ *          so that the compiler can inline /CS control and the data loop of SPI or BUS.
+ * @note In this case, @ref reg_wizchip_cris_cbfunc(), @ref reg_wizchip_cs_cbfunc(), @ref reg_wizchip_spi_cbfunc()\n
+ *       and @ref reg_wizchip_bus_cbfunc() have no effect on the register and buffer accesses.
+ * @todo Define it to 1 and implement the functions of wizchip_port.h for your system.
+ */
+#define _WIZCHIP_PORT_STATIC_          0
+
 
 #if (_WIZCHIP_ == W6100)
    #define _WIZCHIP_ID_                "W6100\0"
@@ -123,10 +149,31 @@ extern "C" {
    */
    //#define _WIZCHIP_IO_MODE_           _WIZCHIP_IO_MODE_BUS_INDIR_
    #define _WIZCHIP_IO_MODE_         _WIZCHIP_IO_MODE_SPI_VDM_
-   //#define _WIZCHIP_IO_MODE_         _WIZCHIP_IO_MODE_SPV_FDM_
+   //#define _WIZCHIP_IO_MODE_         _WIZCHIP_IO_MODE_SPI_FDM_
 
    typedef   uint8_t   iodata_t;       ///< IO access unit. bus width
    typedef   int16_t   datasize_t;     ///< sent or received data size
+   #define _WIZCHIP_SOCK_NUM_   8   ///< The count of independent SOCKET of @ref _WIZCHIP_
+
+   #define WIZCHIP_XFER_READ     0   ///< @ref wiz_XferDesc reads data from @ref _WIZCHIP_.
+   #define WIZCHIP_XFER_WRITE    1   ///< @ref wiz_XferDesc writes data to @ref _WIZCHIP_.
+
+   /**
+    * @ingroup DATA_TYPE
+    * @brief Transfer descriptor for @ref WIZCHIP_XFER_V()
+    * @details @ref wiz_XferDesc describes one access of register or SOCKETn buffer.\n
+    *          <i>hdr</i> is filled by @ref WIZCHIP_XFER_V() before the transfer. It is the address & control phase in SPI mode,\n
+    *          or the values of IDM_AR0, IDM_AR1 and IDM_BSR in BUS indirect mode.
+    * @sa WIZCHIP_XFER_V(), reg_wizchip_xfer_cbfunc()
+    */
+   typedef struct wiz_XferDesc_t
+   {
+      uint32_t    AddrSel;   ///< Register or buffer address such as @ref _Sn_TX_WR_
+      uint8_t*    pBuf;      ///< Data buffer
+      datasize_t  len;       ///< Data length
+      uint8_t     rw;        ///< @ref WIZCHIP_XFER_READ or @ref WIZCHIP_XFER_WRITE
+      uint8_t     hdr[3];    ///< Address & control phase. It is filled by @ref WIZCHIP_XFER_V().
+   }wiz_XferDesc;
    #include "./W6100/w6100.h"
    #include "../Application/Application.h"
 
@@ -138,6 +185,10 @@ extern "C" {
    #error "Undefined _WIZCHIP_IO_MODE_. You should define it !!!"
 #endif
 
+#if (_WIZCHIP_ == W6100) && (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_BUS_DIR_)
+   #error "W6100 has no direct BUS mode. Select _WIZCHIP_IO_MODE_BUS_INDIR_ !!!"
+#endif
+
 /**
  * @brief Define I/O base address of @ref _WIZCHIP_.
  * @todo If you want to use @ref _WIZCHIP_IO_MODE_BUS_ such as @ref _WIZCHIP_IO_MODE_BUS_DIR_ and @ref _WIZCHIP_IO_MODE_BUS_INDIR_,\n
@@ -154,8 +205,6 @@ extern "C" {
 #endif
 
 
-#define _WIZCHIP_SOCK_NUM_   8   ///< The count of independent SOCKET of @ref _WIZCHIP_
-
 
 /********************************************************
 * WIZCHIP BASIC IF functions for SPI, SDIO, I2C , ETC.
@@ -212,6 +261,16 @@ typedef struct __WIZCHIP_T__
       }SPI;
    }IF;    
 
+   ///< The callback function to run a descriptor list at once such as a DMA chain. Refer to @ref reg_wizchip_xfer_cbfunc().
+   void (*_xfer_v) (wiz_XferDesc* xfer, uint8_t cnt);
+
+   ///< The set of asynchronous SPI callback function. Refer to @ref reg_wizchip_spi_async_cbfunc().
+   struct _ASYNC
+   {
+      void      (*_read_byte_buf)  (uint8_t* pBuf, datasize_t len);  ///< Start to read byte data as many as <i>len</i> from @ref _WIZCHIP_ through SPI DMA
+      void      (*_write_byte_buf) (uint8_t* pBuf, datasize_t len);  ///< Start to write byte data as many as <i>len</i> to @ref _WIZCHIP_ through SPI DMA
+   }ASYNC;
+
 }_WIZCHIP_T_;
 
 
@@ -250,6 +309,8 @@ typedef enum
    CW_GET_INTRMASK,       ///< Get the interrupt mask with @ref intr_kind
    CW_SET_INTRTIME,       ///< Set the interrupt pending time 
    CW_GET_INTRTIME,       ///< Get the interrupt pending time
+   CW_SET_INTRMOD,        ///< Set the adaptive interrupt pending time with @ref wiz_IntrMod
+   CW_GET_INTRMOD,        ///< Get the status of the adaptive interrupt pending time with @ref wiz_IntrModStat
    CW_SET_IEN,            ///< Set the global interrupt enable only when @ref SYS_CHIP_LOCK is not set
    CW_GET_IEN,            ///< Get the global interrupt enable 
 
@@ -507,6 +568,66 @@ typedef struct wiz_NetTimeout_t
    uint16_t sl_time_100us;       ///< The retransmission time of SOCKET-less (unit 100us)
 }wiz_NetTimeout;
 
+/**
+ * @ingroup DATA_TYPE
+ * @brief Adaptive Interrupt Pending Time of @ref _WIZCHIP_
+ * @details @ref wiz_IntrMod is a structure type to configure the bounds of @ref _INTPTMR_ tuned by @ref wizchip_intrmod_update().\n
+ *          The event rate at or below <i>low_rate</i> selects <i>min_time</i> for the latency,
+ *          and the event rate at or above <i>high_rate</i> selects <i>max_time</i> for the throughput.
+ *          Between them, @ref _INTPTMR_ is linearly interpolated.
+ * @sa ctlwizchip(), CW_SET_INTRMOD, CW_GET_INTRMOD
+ * @sa wizchip_setintrmod(), wizchip_getintrmod(), wizchip_intrmod_time_handler(), wizchip_intrmod_update()
+ */
+typedef struct wiz_IntrMod_t
+{
+   uint16_t min_time;            ///< The lower bound of @ref _INTPTMR_ (unit 4 SYS_CLK)
+   uint16_t max_time;            ///< The upper bound of @ref _INTPTMR_ (unit 4 SYS_CLK)
+   uint16_t low_rate;            ///< The events per second at or below which <i>min_time</i> is used
+   uint16_t high_rate;           ///< The events per second at or above which <i>max_time</i> is used
+   uint16_t interval;            ///< The tuning interval (unit ms). 0 disables the tuning.
+}wiz_IntrMod;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Status of Adaptive Interrupt Pending Time
+ * @details @ref wiz_IntrModStat is a structure type to indicate the value of @ref _INTPTMR_ chosen by @ref wizchip_intrmod_update()
+ *          and the rates measured in the last interval.
+ * @sa ctlwizchip(), CW_GET_INTRMOD
+ * @sa wizchip_getintrmod()
+ */
+typedef struct wiz_IntrModStat_t
+{
+   uint16_t intptime;            ///< The current value of @ref _INTPTMR_
+   uint32_t intr_rate;           ///< The interrupts per second in the last interval
+   uint32_t event_rate;          ///< The events per second in the last interval
+   uint32_t intr_cnt;            ///< The total count of interrupts
+   uint32_t tune_cnt;            ///< The count of changes of @ref _INTPTMR_
+}wiz_IntrModStat;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Buffer Demand of SOCKETn
+ * @details @ref wiz_BufDemand is a structure type to indicate the buffer use of SOCKETn observed by @ref wizchip_bufmgr_sample()
+ *          and the minimum buffer size pinned by @ref wizchip_bufmgr_setmin(). It is passed to @ref wiz_BufPolicy.
+ * @sa wizchip_bufmgr_init(), wizchip_bufmgr_getdemand()
+ */
+typedef struct wiz_BufDemand_t
+{
+   datasize_t tx_hwm;            ///< The high-water mark of the used TX buffer (unit byte)
+   datasize_t rx_hwm;            ///< The high-water mark of the used RX buffer (unit byte)
+   uint8_t    tx_min;            ///< The pinned minimum TX buffer size (unit KB)
+   uint8_t    rx_min;            ///< The pinned minimum RX buffer size (unit KB)
+}wiz_BufDemand;
+
+/**
+ * @ingroup DATA_TYPE
+ * @brief Buffer Policy of @ref wizchip_bufmgr_rebalance()
+ * @details It fills the wanted TX and RX buffer sizes(unit KB) of all SOCKETs from <i>demand</i>.\n
+ *          The wanted sizes need not be valid. @ref wizchip_bufmgr_rebalance() fits them to the buffer sizes allowed.
+ * @sa wizchip_bufmgr_init(), wizchip_bufpolicy_demand()
+ */
+typedef void (*wiz_BufPolicy)(wiz_BufDemand* demand, uint8_t* txsize, uint8_t* rxsize);
+
 /**
  * @ingroup DATA_TYPE
  * @brief Destination Information for Network Service of @ref _WIZCHIP_
@@ -588,6 +709,19 @@ void reg_wizchip_cris_cbfunc(void(*cris_en)(void), void(*cris_ex)(void));
  */
 void reg_wizchip_cs_cbfunc(void(*cs_sel)(void), void(*cs_desel)(void));
 
+/**
+ * @brief Registers a call back function to run a transfer descriptor list.
+ * @details @ref reg_wizchip_xfer_cbfunc() registers your function which runs <i>cnt</i> transfers of @ref wiz_XferDesc\n
+ *          back-to-back such as a DMA descriptor chain. It is called by @ref WIZCHIP_XFER_V() in the critical section.\n
+ *          For each descriptor, it should select @ref _WIZCHIP_, send <i>hdr</i>,\n
+ *          read or write <i>pBuf</i> as many as <i>len</i> according to <i>rw</i>, and deselect @ref _WIZCHIP_.
+ * @param xfer_v : callback function to run the transfer descriptor list.
+ * @note If you do not register it or register null, @ref WIZCHIP_XFER_V() runs the descriptors\n
+ *       with the callback functions registered by @ref reg_wizchip_cs_cbfunc(), @ref reg_wizchip_spi_cbfunc() or @ref reg_wizchip_bus_cbfunc().
+ * @sa WIZCHIP_XFER_V()
+ */
+void reg_wizchip_xfer_cbfunc(void (*xfer_v)(wiz_XferDesc* xfer, uint8_t cnt));
+
 /// @cond DOXY_APPLY_CODE
 #if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_BUS_)
 /// @endcond
@@ -631,6 +765,22 @@ void reg_wizchip_spi_cbfunc(uint8_t (*spi_rb)(void),
                             void (*spi_wb)(uint8_t wb),
                             void (*spi_rbuf)(uint8_t* buf, datasize_t len),
                             void (*spi_wbuf)(uint8_t* buf, datasize_t len) );
+
+/**
+ * @brief Registers asynchronous call back functions for SPI interface.
+ * @details @ref reg_wizchip_spi_async_cbfunc() is for the asynchronous data functions \n
+ *          such as @ref wiz_send_data_async() and @ref wiz_recv_data_async().\n
+ *          The callback functions should start a SPI DMA transfer and return immediately.\n
+ *          When the transfer is completed, You should call @ref wiz_async_done() to notify the completion.
+ * @param spi_rbuf : callback function to start to read byte data buf as many as <i>len</i>
+ * @param spi_wbuf : callback function to start to write byte data buf as many as <i>len</i>
+ * @note If you do not register them or register null, the asynchronous data functions are run synchronously.\n
+ *       @ref _WIZCHIP_ is selected until @ref wiz_async_done() is called, and the other accesses to @ref _WIZCHIP_ wait for it 
+ *       outside the critical section. So the DMA completion interrupt should be able to preempt the context accessing @ref _WIZCHIP_.
+ * @sa wiz_send_data_async(), wiz_recv_data_async(), wiz_async_done()
+ */
+void reg_wizchip_spi_async_cbfunc(void (*spi_rbuf)(uint8_t* buf, datasize_t len),
+                                  void (*spi_wbuf)(uint8_t* buf, datasize_t len) );
 /// @cond DOXY_APPLY_CODE
 #endif
 /// @endcond
@@ -742,6 +892,115 @@ void wizchip_setinterruptmask(intr_kind intr);
  */
 intr_kind wizchip_getinterruptmask(void);
 
+/**
+ * @ingroup extra_functions
+ * @brief Set the bounds of the adaptive interrupt pending time.
+ * @details @ref _INTPTMR_ is set to <i>min_time</i> of <i>intrmod</i> and the status is cleared.
+ * @param intrmod : @ref wiz_IntrMod
+ * @sa ctlwizchip(), CW_SET_INTRMOD, CW_GET_INTRMOD
+ * @sa wizchip_getintrmod(), wizchip_intrmod_update()
+ */
+void wizchip_setintrmod(wiz_IntrMod* intrmod);
+
+/**
+ * @ingroup extra_functions
+ * @brief Get the status of the adaptive interrupt pending time.
+ * @param stat : @ref wiz_IntrModStat
+ * @sa ctlwizchip(), CW_GET_INTRMOD, CW_SET_INTRMOD
+ * @sa wizchip_setintrmod()
+ */
+void wizchip_getintrmod(wiz_IntrModStat* stat);
+
+/**
+ * @ingroup extra_functions
+ * @brief The time handler of the adaptive interrupt pending time.
+ * @details It should be called every 1ms by a timer. It doesn't access @ref _WIZCHIP_.
+ * @sa wizchip_intrmod_update()
+ */
+void wizchip_intrmod_time_handler(void);
+
+/**
+ * @ingroup extra_functions
+ * @brief Counts an interrupt and tunes @ref _INTPTMR_.
+ * @details It should be called once per INTn interrupt after the interrupts are cleared. @ref wiz_sock_isr() calls it.\n
+ *          Every interval of @ref wiz_IntrMod, it calculates the event rate and writes @ref _INTPTMR_ only when the value is changed.\n
+ *          The event rate is used instead of the interrupt rate, because the interrupt rate is limited by @ref _INTPTMR_ itself.
+ * @param events : The count of events handled by the interrupt
+ * @sa wizchip_setintrmod(), wizchip_intrmod_time_handler()
+ */
+void wizchip_intrmod_update(uint8_t events);
+
+/**
+ * @ingroup extra_functions
+ * @brief Start or stop the buffer manager.
+ * @details The observed demand is cleared. While <i>policy</i> is set, @ref close() calls @ref wizchip_bufmgr_rebalance().\n
+ *          It should be called after @ref wizchip_init().
+ * @param policy : @ref wiz_BufPolicy such as @ref wizchip_bufpolicy_demand(). 0 stops the buffer manager.
+ * @sa wizchip_bufmgr_sample(), wizchip_bufmgr_rebalance(), wizchip_bufmgr_active()
+ */
+void wizchip_bufmgr_init(wiz_BufPolicy policy);
+
+/**
+ * @ingroup extra_functions
+ * @brief Check the buffer manager is started.
+ * @return 1 : A @ref wiz_BufPolicy is set by @ref wizchip_bufmgr_init(), 0 : The buffer manager is stopped.
+ * @sa wizchip_bufmgr_init()
+ */
+uint8_t wizchip_bufmgr_active(void);
+
+/**
+ * @ingroup extra_functions
+ * @brief Pin the minimum buffer sizes of SOCKETn.
+ * @param sn : SOCKET number
+ * @param txmin : The minimum TX buffer size (unit KB)
+ * @param rxmin : The minimum RX buffer size (unit KB)
+ * @sa wizchip_bufmgr_init()
+ */
+void wizchip_bufmgr_setmin(uint8_t sn, uint8_t txmin, uint8_t rxmin);
+
+/**
+ * @ingroup extra_functions
+ * @brief Record the buffer use of SOCKETn.
+ * @details It reads @ref _Sn_RX_RSR_ and @ref _Sn_TX_FSR_ and raises the high-water marks of @ref wiz_BufDemand.\n
+ *          It should be called periodically, for example after @ref recv() or @ref send().
+ * @param sn : SOCKET number
+ * @sa wizchip_bufmgr_getdemand()
+ */
+void wizchip_bufmgr_sample(uint8_t sn);
+
+/**
+ * @ingroup extra_functions
+ * @brief Get the buffer demand of SOCKETn.
+ * @param sn : SOCKET number
+ * @param demand : @ref wiz_BufDemand
+ * @sa wizchip_bufmgr_sample()
+ */
+void wizchip_bufmgr_getdemand(uint8_t sn, wiz_BufDemand* demand);
+
+/**
+ * @ingroup extra_functions
+ * @brief Redistribute the buffers of the closed SOCKETs after the last open SOCKET.
+ * @details It gets the wanted sizes from @ref wiz_BufPolicy and sets @ref _Sn_TX_BSR_ and @ref _Sn_RX_BSR_ of the closed SOCKETs
+ *          after the last open SOCKET.\n
+ *          The buffers are allocated sequentially from SOCKET0, so resizing a SOCKET moves the buffers of all the next SOCKETs.
+ *          To keep the base and size of every open SOCKET, the sizes of SOCKET0 ~ the last open SOCKET are kept,
+ *          including the closed SOCKETs between them, and the closed SOCKETs after the last open SOCKET share the rest of the 16KB memory.\n
+ *          The sizes are rounded to 0, 1, 2, 4, 8, or 16KB.\n
+ *          After the redistribution, the high-water marks are halved so that old demand fades.
+ * @return 0 : The sizes are checked, -1 : The buffer manager is not started.
+ * @sa wizchip_bufmgr_init()
+ */
+int8_t wizchip_bufmgr_rebalance(void);
+
+/**
+ * @ingroup extra_functions
+ * @brief The buffer policy proportional to demand.
+ * @details It shares the 16KB TX and RX memory in proportion to the high-water marks. 
+ *          Each SOCKET wants 1KB and its pinned minimum at least. Without any demand, each SOCKET wants 2KB.
+ * @sa wiz_BufPolicy, wizchip_bufmgr_init()
+ */
+void wizchip_bufpolicy_demand(wiz_BufDemand* demand, uint8_t* txsize, uint8_t* rxsize);
+
 /** 
  * @ingroup extra_functions
  * @brief Get the Link status of integrated PHY.
@@ -959,6 +1218,13 @@ int8_t wizchip_unsolicited(void);
  */
 int8_t wizchip_getprefix(wiz_Prefix * prefix);
 
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_PORT_STATIC_ == 1)
+/// @endcond
+   #include "wizchip_port.h"
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,166 @@
+//* ****************************************************************************
+//! \file wizchip_port.h
+//! \brief WIZCHIP HOST interface port Header File.
+//! \version 1.0.0
+//! \date 2019/01/01
+//! \par  Revision history
+//!       <2019/01/01> 1st Release
+//! \author MidnightCow
+//! \copyright
+//!
+//! Copyright (c)  2019, WIZnet Co., LTD.
+//!
+//! Permission is hereby granted, free of charge, to any person obtaining a copy
+//! of this software and associated documentation files (the "Software"), to deal
+//! in the Software without restriction, including without limitation the rights
+//! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//! copies of the Software, and to permit persons to whom the Software is
+//! furnished to do so, subject to the following conditions:
+//!
+//! The above copyright notice and this permission notice shall be included in
+//! all copies or substantial portions of the Software.
+//!
+//! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//! SOFTWARE.
+//!
+//*****************************************************************************
+
+#ifndef  _WIZCHIP_PORT_H_
+#define  _WIZCHIP_PORT_H_
+
+#include <stddef.h>
+
+/**
+ * @file wizchip_port.h
+ * @brief HOST interface functions called directly when @ref _WIZCHIP_PORT_STATIC_ is 1.
+ * @details It is included at the end of wizchip_conf.h.\n
+ *          These functions are called by @ref WIZCHIP_READ(), @ref WIZCHIP_WRITE(), @ref WIZCHIP_READ_BUF() and @ref WIZCHIP_WRITE_BUF()\n
+ *          instead of the callback functions of @ref WIZCHIP. They are the same as the default functions of wizchip_conf.c.
+ * @todo You should replace their bodies with the code of your system, such as the SPI data register and the GPIO of /CS.\n
+ *       You can include the header files of your system here.
+ */
+
+/**
+ * @brief Enter a critical section.
+ * @sa wizchip_port_cris_exit(), WIZCHIP_CRITICAL_ENTER()
+ */
+static inline void wizchip_port_cris_enter(void) {}
+
+/**
+ * @brief Exit a critical section.
+ * @sa wizchip_port_cris_enter(), WIZCHIP_CRITICAL_EXIT()
+ */
+static inline void wizchip_port_cris_exit(void) {}
+
+/**
+ * @brief Select @ref _WIZCHIP_.
+ * @sa wizchip_port_cs_deselect()
+ */
+static inline void wizchip_port_cs_select(void) {}
+
+/**
+ * @brief De-select @ref _WIZCHIP_.
+ * @sa wizchip_port_cs_select()
+ */
+static inline void wizchip_port_cs_deselect(void) {}
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
+/// @endcond
+/**
+ * @brief Read a byte through SPI.
+ * @return The read byte
+ */
+static inline uint8_t wizchip_port_spi_read_byte(void) { return 0; }
+
+/**
+ * @brief Write a byte through SPI.
+ * @param wb The byte to be written
+ */
+static inline void wizchip_port_spi_write_byte(uint8_t wb) { (void)wb; }
+
+/**
+ * @brief Read bytes as many as <i>len</i> through SPI.
+ * @param pBuf Buffer to save the read bytes
+ * @param len The count of bytes
+ */
+static inline void wizchip_port_spi_read_buf(uint8_t* pBuf, datasize_t len)
+{
+   datasize_t i;
+   for(i = 0; i < len; i++) pBuf[i] = wizchip_port_spi_read_byte();
+}
+
+/**
+ * @brief Write bytes as many as <i>len</i> through SPI.
+ * @param pBuf Buffer of bytes to be written
+ * @param len The count of bytes
+ */
+static inline void wizchip_port_spi_write_buf(uint8_t* pBuf, datasize_t len)
+{
+   datasize_t i;
+   for(i = 0; i < len; i++) wizchip_port_spi_write_byte(pBuf[i]);
+}
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_BUS_)
+/// @endcond
+/**
+ * @brief Read one @ref iodata_t through BUS.
+ * @param AddrSel The memory-mapped address such as @ref IDM_DR
+ * @return The read @ref iodata_t
+ */
+static inline iodata_t wizchip_port_bus_read(uint32_t AddrSel) { return *((volatile iodata_t*)((ptrdiff_t)AddrSel)); }
+
+/**
+ * @brief Write one @ref iodata_t through BUS.
+ * @param AddrSel The memory-mapped address such as @ref IDM_DR
+ * @param wb @ref iodata_t to be written
+ */
+static inline void wizchip_port_bus_write(uint32_t AddrSel, iodata_t wb) { *((volatile iodata_t*)((ptrdiff_t)AddrSel)) = wb; }
+
+/**
+ * @brief Read @ref iodata_t as many as <i>len</i> through BUS.
+ * @param AddrSel The memory-mapped address
+ * @param pBuf Buffer to save the read data
+ * @param len The count of @ref iodata_t
+ * @param addrinc 0 : The address is not increased, 1 : Increased
+ */
+static inline void wizchip_port_bus_read_buf(uint32_t AddrSel, iodata_t* pBuf, datasize_t len, uint8_t addrinc)
+{
+   datasize_t i;
+   for(i = 0; i < len; i++)
+   {
+      pBuf[i] = wizchip_port_bus_read(AddrSel);
+      if(addrinc) AddrSel += sizeof(iodata_t);
+   }
+}
+
+/**
+ * @brief Write @ref iodata_t as many as <i>len</i> through BUS.
+ * @param AddrSel The memory-mapped address
+ * @param pBuf Buffer of data to be written
+ * @param len The count of @ref iodata_t
+ * @param addrinc 0 : The address is not increased, 1 : Increased
+ */
+static inline void wizchip_port_bus_write_buf(uint32_t AddrSel, iodata_t* pBuf, datasize_t len, uint8_t addrinc)
+{
+   datasize_t i;
+   for(i = 0; i < len; i++)
+   {
+      wizchip_port_bus_write(AddrSel, pBuf[i]);
+      if(addrinc) AddrSel += sizeof(iodata_t);
+   }
+}
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
+
+#endif   // _WIZCHIP_PORT_H_
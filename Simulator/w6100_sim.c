@@ -0,0 +1,770 @@
+//*****************************************************************************
+//
+//! \file w6100_sim.c
+//! \brief W6100 Host Simulator Implements file.
+//! \version 1.0.0
+//! \date 2026/10/17
+//! \par  Revision history
+//!       <2026/10/17> 1st Release
+//! \author io6Library contributors
+//! \copyright
+//!
+//! Copyright (c)  2026, io6Library contributors.
+//!
+//! Permission is hereby granted, free of charge, to any person obtaining a copy
+//! of this software and associated documentation files (the "Software"), to deal
+//! in the Software without restriction, including without limitation the rights
+//! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//! copies of the Software, and to permit persons to whom the Software is
+//! furnished to do so, subject to the following conditions:
+//!
+//! The above copyright notice and this permission notice shall be included in
+//! all copies or substantial portions of the Software.
+//!
+//! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//! SOFTWARE.
+//!
+//*****************************************************************************
+
+#include <string.h>
+#include "socket.h"
+#include "w6100_sim.h"
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_ == W6100)
+/// @endcond
+
+#define SIM_OFS(ADDR)         ((uint16_t)(((ADDR) >> 8) & 0xFFFF))   ///< Offset address of a register address
+#define SIM_SOFS(REG)         SIM_OFS(REG(0))                        ///< Offset address of a SOCKETn register address
+
+#define SIM_CREG_SIZE         (SIM_OFS(_SLHOPR_) + 1)
+#define SIM_SREG_SIZE         (SIM_SOFS(_Sn_RX_WR_) + 2)
+#define SIM_BUF_SIZE          (16 * 1024)
+
+#define SIM_CIDR              (0x6100)
+#define SIM_VER               (0x4661)
+
+#define SIM_CHPLCKR_UNLOCK    (0xCE)
+#define SIM_NETLCKR_UNLOCK    (0x3A)
+#define SIM_NETLCKR_LOCK      (0xC5)
+#define SIM_PHYLCKR_UNLOCK    (0x53)
+
+static uint8_t  sim_creg[SIM_CREG_SIZE];
+static uint8_t  sim_sreg[_WIZCHIP_SOCK_NUM_][SIM_SREG_SIZE];
+static uint8_t  sim_txmem[SIM_BUF_SIZE];
+static uint8_t  sim_rxmem[SIM_BUF_SIZE];
+static uint8_t  sim_txpkt[SIM_BUF_SIZE];
+static uint16_t sim_phyreg[32];
+
+static uint8_t  sim_lock;                         // SYSR_CHPL | SYSR_NETL | SYSR_PHYL
+static uint16_t sim_rx_ack[_WIZCHIP_SOCK_NUM_];   // Sn_RX_RD latched by Sn_CR_RECV
+static uint8_t  sim_cr[_WIZCHIP_SOCK_NUM_];       // the command in progress
+static uint8_t  sim_cr_busy[_WIZCHIP_SOCK_NUM_];  // remained Sn_CR reads before the command is cleared
+static int32_t  sim_peer_win[_WIZCHIP_SOCK_NUM_]; // the window of the TCP peer. -1 : unlimited
+
+static wiz_SimCost sim_cost;
+static wiz_SimStat sim_stat;
+
+static void (*sim_txcb)(uint8_t sn, uint8_t* addr, uint8_t addrlen, uint16_t port, uint8_t* buf, datasize_t len) = 0;
+
+static uint16_t sim_get16(uint8_t* p)
+{
+   return (((uint16_t)p[0]) << 8) + p[1];
+}
+
+static void sim_set16(uint8_t* p, uint16_t v)
+{
+   p[0] = (uint8_t)(v >> 8);
+   p[1] = (uint8_t)v;
+}
+
+#define SIM_Sn(sn, REG)       (&sim_sreg[sn][SIM_SOFS(REG)])
+#define SIM_CR(REG)           (&sim_creg[SIM_OFS(REG)])
+
+static uint16_t sim_bufbase(uint8_t sn, uint32_t bsr)
+{
+   uint16_t base = 0;
+   uint8_t i;
+   for(i = 0; i < sn; i++) base += ((uint16_t)sim_sreg[i][SIM_OFS(bsr)]) << 10;
+   return base;
+}
+
+static uint8_t* sim_bufptr(uint8_t sn, uint8_t is_tx, uint16_t ptr)
+{
+   uint16_t base, size;
+   if(is_tx)
+   {
+      base = sim_bufbase(sn, (uint32_t)_Sn_TX_BSR_(0));
+      size = ((uint16_t)*SIM_Sn(sn,_Sn_TX_BSR_)) << 10;
+   }
+   else
+   {
+      base = sim_bufbase(sn, (uint32_t)_Sn_RX_BSR_(0));
+      size = ((uint16_t)*SIM_Sn(sn,_Sn_RX_BSR_)) << 10;
+   }
+   if(size == 0 || ((uint32_t)base + size) > SIM_BUF_SIZE) return 0;
+   return (is_tx ? sim_txmem : sim_rxmem) + base + (ptr & (size - 1));
+}
+
+static void sim_copy_from_ring(uint8_t sn, uint16_t ptr, uint8_t* buf, uint16_t len)
+{
+   uint8_t* p;
+   while(len--)
+   {
+      p = sim_bufptr(sn, 1, ptr++);
+      *buf++ = p ? *p : 0;
+   }
+}
+
+static void sim_copy_to_ring(uint8_t sn, uint16_t ptr, uint8_t* buf, uint16_t len)
+{
+   uint8_t* p;
+   while(len--)
+   {
+      p = sim_bufptr(sn, 0, ptr++);
+      if(p) *p = *buf;
+      buf++;
+   }
+}
+
+static uint16_t sim_rx_size(uint8_t sn)
+{
+   return ((uint16_t)*SIM_Sn(sn,_Sn_RX_BSR_)) << 10;
+}
+
+static uint16_t sim_rx_used(uint8_t sn)
+{
+   return sim_get16(SIM_Sn(sn,_Sn_RX_WR_)) - sim_rx_ack[sn];
+}
+
+static void sim_sock_reset(uint8_t sn)
+{
+   memset(sim_sreg[sn], 0, SIM_SREG_SIZE);
+   *SIM_Sn(sn,_Sn_IMR_)     = 0xFF;
+   *SIM_Sn(sn,_Sn_TTLR_)    = 0x80;
+   sim_set16(SIM_Sn(sn,_Sn_FRGR_), 0x4000);
+   sim_set16(SIM_Sn(sn,_Sn_RTR_),  0x07D0);
+   *SIM_Sn(sn,_Sn_RCR_)     = 0x08;
+   *SIM_Sn(sn,_Sn_TX_BSR_)  = 2;
+   *SIM_Sn(sn,_Sn_RX_BSR_)  = 2;
+   sim_rx_ack[sn]  = 0;
+   sim_cr[sn]      = 0;
+   sim_cr_busy[sn] = 0;
+   sim_peer_win[sn] = -1;
+}
+
+void w6100_sim_reset(void)
+{
+   uint8_t i;
+   memset(sim_creg, 0, sizeof(sim_creg));
+   memset(sim_txmem, 0, sizeof(sim_txmem));
+   memset(sim_rxmem, 0, sizeof(sim_rxmem));
+   memset(sim_phyreg, 0, sizeof(sim_phyreg));
+   sim_set16(SIM_CR(_CIDR_), SIM_CIDR);
+   sim_set16(SIM_CR(_VER_),  SIM_VER);
+   *SIM_CR(_SYCR0_) = 0x80;
+   *SIM_CR(_SYCR1_) = SYCR1_IEN;
+   sim_set16(SIM_CR(_RTR_), 0x07D0);
+   *SIM_CR(_RCR_)   = 0x08;
+   sim_set16(SIM_CR(_SLRTR_), 0x07D0);
+   *SIM_CR(_SLHOPR_) = 0x80;
+   sim_lock = SYSR_CHPL | SYSR_NETL | SYSR_PHYL;
+   for(i = 0; i < _WIZCHIP_SOCK_NUM_; i++) sim_sock_reset(i);
+}
+
+static void sim_send(uint8_t sn, uint8_t cmd)
+{
+   uint8_t  mr = *SIM_Sn(sn,_Sn_MR_) & 0x0F;
+   uint8_t* addr = 0;
+   uint8_t  addrlen = 0;
+   uint16_t port = 0;
+   uint16_t rd = sim_get16(SIM_Sn(sn,_Sn_TX_RD_));
+   uint16_t len = sim_get16(SIM_Sn(sn,_Sn_TX_WR_)) - rd;
+   uint16_t all = len;
+
+   if(cmd == Sn_CR_SEND_KEEP) len = all = 0;
+   switch(*SIM_Sn(sn,_Sn_SR_))
+   {
+      case SOCK_ESTABLISHED:
+      case SOCK_CLOSE_WAIT:
+         if(sim_peer_win[sn] >= 0)
+         {
+            if(len > sim_peer_win[sn]) len = (uint16_t)sim_peer_win[sn];
+            sim_peer_win[sn] -= len;
+         }
+         if(*SIM_Sn(sn,_Sn_ESR_) & Sn_ESR_TCPM) cmd = Sn_CR_SEND6;
+         else                                   cmd = Sn_CR_SEND;
+         /* falls through */
+      case SOCK_UDP:
+      case SOCK_IPRAW4:
+      case SOCK_IPRAW6:
+         if(cmd == Sn_CR_SEND6 || mr == Sn_MR_IPRAW6) { addr = SIM_Sn(sn,_Sn_DIP6R_); addrlen = 16; }
+         else                                         { addr = SIM_Sn(sn,_Sn_DIPR_);  addrlen = 4;  }
+         if(mr != Sn_MR_IPRAW4 && mr != Sn_MR_IPRAW6) port = sim_get16(SIM_Sn(sn,_Sn_DPORTR_));
+         /* falls through */
+      case SOCK_MACRAW:
+         break;
+      default:
+         *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_TIMEOUT;
+         return;
+   }
+   if(len > SIM_BUF_SIZE) len = SIM_BUF_SIZE;
+   sim_copy_from_ring(sn, rd, sim_txpkt, len);
+   if(sim_txcb && len) sim_txcb(sn, addr, addrlen, port, sim_txpkt, (datasize_t)len);
+   sim_set16(SIM_Sn(sn,_Sn_TX_RD_), rd + len);
+   if(len == all) *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_SENDOK;   // the rest is sent when the peer opens the window.
+}
+
+static void sim_command(uint8_t sn, uint8_t cmd)
+{
+   uint8_t* sr = SIM_Sn(sn,_Sn_SR_);
+   sim_stat.cmds++;
+   sim_cr[sn] = cmd;
+   sim_cr_busy[sn] = sim_cost.cr_busy_reads;
+   switch(cmd)
+   {
+      case Sn_CR_OPEN:
+         switch(*SIM_Sn(sn,_Sn_MR_) & 0x0F)
+         {
+            case Sn_MR_TCP4:
+            case Sn_MR_TCP6:
+            case Sn_MR_TCPD:
+               *sr = SOCK_INIT;
+               break;
+            case Sn_MR_UDP4:
+            case Sn_MR_UDP6:
+            case Sn_MR_UDPD:
+               *sr = SOCK_UDP;
+               break;
+            case Sn_MR_IPRAW4:
+               *sr = SOCK_IPRAW4;
+               break;
+            case Sn_MR_IPRAW6:
+               *sr = SOCK_IPRAW6;
+               break;
+            case Sn_MR_MACRAW:
+               if(sn == 0) *sr = SOCK_MACRAW;
+               break;
+            default:
+               break;
+         }
+         sim_set16(SIM_Sn(sn,_Sn_TX_RD_), 0);
+         sim_set16(SIM_Sn(sn,_Sn_TX_WR_), 0);
+         sim_set16(SIM_Sn(sn,_Sn_RX_RD_), 0);
+         sim_set16(SIM_Sn(sn,_Sn_RX_WR_), 0);
+         sim_rx_ack[sn] = 0;
+         *SIM_Sn(sn,_Sn_ESR_) = 0;
+         break;
+      case Sn_CR_LISTEN:
+         if(*sr == SOCK_INIT) *sr = SOCK_LISTEN;
+         break;
+      case Sn_CR_CONNECT:
+      case Sn_CR_CONNECT6:
+         if(*sr != SOCK_INIT) break;
+         *sr = SOCK_ESTABLISHED;
+         *SIM_Sn(sn,_Sn_ESR_) = Sn_ESR_TCPOP_CLT | ((cmd == Sn_CR_CONNECT6) ? Sn_ESR_TCPM_IPV6 : Sn_ESR_TCPM_IPV4);
+         *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_CON;
+         break;
+      case Sn_CR_DISCON:
+         if(*sr == SOCK_ESTABLISHED || *sr == SOCK_CLOSE_WAIT)
+         {
+            *sr = SOCK_CLOSED;
+            *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_DISCON;
+         }
+         break;
+      case Sn_CR_CLOSE:
+         *sr = SOCK_CLOSED;
+         break;
+      case Sn_CR_SEND:
+      case Sn_CR_SEND6:
+      case Sn_CR_SEND_KEEP:
+         sim_send(sn, cmd);
+         break;
+      case Sn_CR_RECV:
+         sim_rx_ack[sn] = sim_get16(SIM_Sn(sn,_Sn_RX_RD_));
+         if(sim_rx_used(sn)) *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_RECV;
+         break;
+      default:
+         break;
+   }
+}
+
+static uint8_t sim_creg_read(uint16_t ofs)
+{
+   uint8_t sn, ret = 0;
+   if(ofs >= SIM_CREG_SIZE) return 0;
+   if(ofs == SIM_OFS(_SYSR_))
+   {
+      ret = sim_lock;
+   #if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
+      ret |= SYSR_SPI;
+   #endif
+      return ret;
+   }
+   if(ofs == SIM_OFS(_SIR_))
+   {
+      for(sn = 0; sn < _WIZCHIP_SOCK_NUM_; sn++)
+         if(*SIM_Sn(sn,_Sn_IR_) & *SIM_Sn(sn,_Sn_IMR_)) ret |= (1 << sn);
+      return ret;
+   }
+   if(ofs == SIM_OFS(_TCNTR_))   // Each read of TCNTR passes 100us, so that a timeout polling TCNTR can expire.
+      sim_set16(SIM_CR(_TCNTR_), sim_get16(SIM_CR(_TCNTR_)) + 1);
+   if(ofs == SIM_OFS(_PHYSR_)) return PHYSR_LNK_UP | PHYSR_SPD_100M | PHYSR_DPX_FULL;
+   if(ofs == SIM_OFS(_CHPLCKR_) || ofs == SIM_OFS(_NETLCKR_) || ofs == SIM_OFS(_PHYLCKR_)) return 0;
+   return sim_creg[ofs];
+}
+
+static void sim_creg_write(uint16_t ofs, uint8_t wb)
+{
+   uint16_t phyreg;
+   if(ofs >= SIM_CREG_SIZE) return;
+   if(ofs == SIM_OFS(_CIDR_) || ofs == SIM_OFS(_CIDR_) + 1 || ofs == SIM_OFS(_VER_) || ofs == SIM_OFS(_VER_) + 1 ||
+      ofs == SIM_OFS(_SYSR_) || ofs == SIM_OFS(_IR_) || ofs == SIM_OFS(_SIR_) || ofs == SIM_OFS(_SLIR_) ||
+      ofs == SIM_OFS(_PHYSR_) || ofs == SIM_OFS(_TCNTR_) || ofs == SIM_OFS(_TCNTR_) + 1)
+      return;
+
+   if(ofs == SIM_OFS(_CHPLCKR_))
+   {
+      if(wb == SIM_CHPLCKR_UNLOCK) sim_lock &= ~SYSR_CHPL;
+      else                         sim_lock |= SYSR_CHPL;
+   }
+   else if(ofs == SIM_OFS(_NETLCKR_))
+   {
+      if(wb == SIM_NETLCKR_UNLOCK)    sim_lock &= ~SYSR_NETL;
+      else if(wb == SIM_NETLCKR_LOCK) sim_lock |= SYSR_NETL;
+   }
+   else if(ofs == SIM_OFS(_PHYLCKR_))
+   {
+      if(wb == SIM_PHYLCKR_UNLOCK) sim_lock &= ~SYSR_PHYL;
+      else                         sim_lock |= SYSR_PHYL;
+   }
+   else if(ofs == SIM_OFS(_SYCR0_) || ofs == SIM_OFS(_SYCR1_))
+   {
+      if(sim_lock & SYSR_CHPL) return;
+      if(ofs == SIM_OFS(_SYCR0_) && !(wb & 0x80)) w6100_sim_reset();
+      else sim_creg[ofs] = wb;
+   }
+   else if(ofs >= SIM_OFS(_SHAR_) && ofs < SIM_OFS(_SLDIP6R_))
+   {
+      if(!(sim_lock & SYSR_NETL)) sim_creg[ofs] = wb;
+   }
+   else if(ofs == SIM_OFS(_PHYCR0_) || ofs == SIM_OFS(_PHYCR1_))
+   {
+      if(!(sim_lock & SYSR_PHYL)) sim_creg[ofs] = wb;
+   }
+   else if(ofs == SIM_OFS(_IRCLR_))     sim_creg[SIM_OFS(_IR_)]   &= ~wb;
+   else if(ofs == SIM_OFS(_SLIRCLR_))   sim_creg[SIM_OFS(_SLIR_)] &= ~wb;
+   else if(ofs == SIM_OFS(_TCNTRCLR_))  sim_set16(SIM_CR(_TCNTR_), 0);
+   else if(ofs == SIM_OFS(_SLCR_))
+   {
+      // No network is attached. Every Socket-less command is timed out.
+      if(wb) sim_creg[SIM_OFS(_SLIR_)] |= SLIR_TOUT;
+   }
+   else if(ofs == SIM_OFS(_PHYACR_))
+   {
+      phyreg = sim_creg[SIM_OFS(_PHYRAR_)] & 0x1F;
+      if(wb == PHYACR_WRITE)
+      {
+         sim_phyreg[phyreg] = (((uint16_t)sim_creg[SIM_OFS(_PHYDIR_) + 1]) << 8) + sim_creg[SIM_OFS(_PHYDIR_)];
+      }
+      else if(wb == PHYACR_READ)
+      {
+         sim_creg[SIM_OFS(_PHYDOR_)]     = (uint8_t)sim_phyreg[phyreg];          // low byte first
+         sim_creg[SIM_OFS(_PHYDOR_) + 1] = (uint8_t)(sim_phyreg[phyreg] >> 8);
+      }
+   }
+   else sim_creg[ofs] = wb;
+}
+
+static uint8_t sim_sreg_read(uint8_t sn, uint16_t ofs)
+{
+   uint16_t val;
+   if(ofs >= SIM_SREG_SIZE) return 0;
+   if(ofs == SIM_SOFS(_Sn_CR_))
+   {
+      sim_stat.cr_polls++;
+      if(sim_cr_busy[sn] == 0) return 0;
+      sim_cr_busy[sn]--;
+      return sim_cr[sn];
+   }
+   if(ofs == SIM_SOFS(_Sn_TX_FSR_) || ofs == SIM_SOFS(_Sn_TX_FSR_) + 1)
+   {
+      val = (((uint16_t)*SIM_Sn(sn,_Sn_TX_BSR_)) << 10) -
+            (uint16_t)(sim_get16(SIM_Sn(sn,_Sn_TX_WR_)) - sim_get16(SIM_Sn(sn,_Sn_TX_RD_)));
+      return (ofs == SIM_SOFS(_Sn_TX_FSR_)) ? (uint8_t)(val >> 8) : (uint8_t)val;
+   }
+   if(ofs == SIM_SOFS(_Sn_RX_RSR_) || ofs == SIM_SOFS(_Sn_RX_RSR_) + 1)
+   {
+      val = sim_rx_used(sn);
+      return (ofs == SIM_SOFS(_Sn_RX_RSR_)) ? (uint8_t)(val >> 8) : (uint8_t)val;
+   }
+   return sim_sreg[sn][ofs];
+}
+
+static void sim_sreg_write(uint8_t sn, uint16_t ofs, uint8_t wb)
+{
+   if(ofs >= SIM_SREG_SIZE) return;
+   if(ofs == SIM_SOFS(_Sn_CR_))
+   {
+      sim_command(sn, wb);
+      return;
+   }
+   if(ofs == SIM_SOFS(_Sn_IRCLR_))
+   {
+      *SIM_Sn(sn,_Sn_IR_) &= ~wb;
+      return;
+   }
+   if(ofs == SIM_SOFS(_Sn_IR_)     || ofs == SIM_SOFS(_Sn_SR_)      || ofs == SIM_SOFS(_Sn_ESR_) ||
+      ofs == SIM_SOFS(_Sn_TX_FSR_) || ofs == SIM_SOFS(_Sn_TX_FSR_) + 1 ||
+      ofs == SIM_SOFS(_Sn_TX_RD_)  || ofs == SIM_SOFS(_Sn_TX_RD_)  + 1 ||
+      ofs == SIM_SOFS(_Sn_RX_RSR_) || ofs == SIM_SOFS(_Sn_RX_RSR_) + 1 ||
+      ofs == SIM_SOFS(_Sn_RX_WR_)  || ofs == SIM_SOFS(_Sn_RX_WR_)  + 1)
+      return;
+   sim_sreg[sn][ofs] = wb;
+}
+
+/*
+ * Block Select Bits : 0 - Common register, (1+4n) - SOCKETn register, (2+4n) - SOCKETn TX buffer, (3+4n) - SOCKETn RX buffer
+ */
+static uint8_t sim_read(uint16_t ofs, uint8_t bsb)
+{
+   uint8_t  sn = (bsb >> 2);
+   uint8_t* p;
+   if(bsb == 0)                  return sim_creg_read(ofs);
+   if(sn >= _WIZCHIP_SOCK_NUM_)  return 0;
+   switch(bsb & 0x03)
+   {
+      case 1:  return sim_sreg_read(sn, ofs);
+      case 2:  p = sim_bufptr(sn, 1, ofs); return p ? *p : 0;
+      case 3:  p = sim_bufptr(sn, 0, ofs); return p ? *p : 0;
+      default: return 0;
+   }
+}
+
+static void sim_write(uint16_t ofs, uint8_t bsb, uint8_t wb)
+{
+   uint8_t  sn = (bsb >> 2);
+   uint8_t* p;
+   if(bsb == 0)                  { sim_creg_write(ofs, wb); return; }
+   if(sn >= _WIZCHIP_SOCK_NUM_)  return;
+   switch(bsb & 0x03)
+   {
+      case 1:  sim_sreg_write(sn, ofs, wb);  break;
+      case 2:  if((p = sim_bufptr(sn, 1, ofs)) != 0) *p = wb;  break;
+      case 3:  if((p = sim_bufptr(sn, 0, ofs)) != 0) *p = wb;  break;
+      default: break;
+   }
+}
+
+///////////////////////////////////
+// HOST interface emulation      //
+///////////////////////////////////
+
+static uint16_t sim_ofs;       // Offset Address
+static uint8_t  sim_ctl;       // Control phase : BSB[7:3], RWB[2], OM[1:0]
+
+static void sim_cris_enter(void) { sim_stat.cris++; }
+static void sim_cris_exit(void)  {}
+
+/// @cond DOXY_APPLY_CODE
+#if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
+/// @endcond
+
+static uint8_t  sim_hdr_cnt;   // received bytes of address & control phase in the current frame
+static uint8_t  sim_data_cnt;  // data bytes in the current frame
+
+static void sim_cs_select(void)   { sim_hdr_cnt = 0; }
+static void sim_cs_deselect(void) { sim_hdr_cnt = 0; }
+
+static uint8_t sim_spi_fdm_len(void)
+{
+   switch(sim_ctl & 0x03)
+   {
+      case 1:  return 1;
+      case 2:  return 2;
+      case 3:  return 4;
+      default: return 0;   // VDM
+   }
+}
+
+// A frame of FDM is closed after its fixed data length. The next byte is a new address phase.
+static void sim_spi_data_done(void)
+{
+   uint8_t fdm = sim_spi_fdm_len();
+   if(fdm && ++sim_data_cnt >= fdm) sim_hdr_cnt = 0;
+}
+
+static void sim_spi_byte_in(uint8_t wb)
+{
+   if(sim_hdr_cnt < 3)
+   {
+      sim_stat.hdr_bytes++;
+      switch(sim_hdr_cnt++)
+      {
+         case 0: sim_ofs = ((uint16_t)wb) << 8; break;
+         case 1: sim_ofs |= wb;                 break;
+         default:
+            sim_ctl = wb;
+            sim_data_cnt = 0;
+            sim_stat.frames++;
+            break;
+      }
+      return;
+   }
+   sim_stat.wr_bytes++;
+   if(sim_ctl & _W6100_SPI_WRITE_) sim_write(sim_ofs++, sim_ctl >> 3, wb);
+   sim_spi_data_done();
+}
+
+static uint8_t sim_spi_byte_out(void)
+{
+   uint8_t ret;
+   if(sim_hdr_cnt < 3 || (sim_ctl & _W6100_SPI_WRITE_)) return 0xFF;
+   sim_stat.rd_bytes++;
+   ret = sim_read(sim_ofs++, sim_ctl >> 3);
+   sim_spi_data_done();
+   return ret;
+}
+
+static uint8_t sim_spi_readbyte(void)
+{
+   sim_stat.calls++;
+   return sim_spi_byte_out();
+}
+
+static void sim_spi_writebyte(uint8_t wb)
+{
+   sim_stat.calls++;
+   sim_spi_byte_in(wb);
+}
+
+static void sim_spi_readburst(uint8_t* pBuf, datasize_t len)
+{
+   sim_stat.calls++;
+   while(len-- > 0) *pBuf++ = sim_spi_byte_out();
+}
+
+static void sim_spi_writeburst(uint8_t* pBuf, datasize_t len)
+{
+   sim_stat.calls++;
+   while(len-- > 0) sim_spi_byte_in(*pBuf++);
+}
+
+/// @cond DOXY_APPLY_CODE
+#elif (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_BUS_)
+/// @endcond
+
+static void sim_cs_select(void)   { sim_stat.frames++; }
+static void sim_cs_deselect(void) {}
+
+static iodata_t sim_bus_rd(uint32_t addr)
+{
+   switch(addr - _WIZCHIP_IO_BASE_)
+   {
+      case 0: return (iodata_t)(sim_ofs >> 8);
+      case 1: return (iodata_t)sim_ofs;
+      case 2: return sim_ctl;
+      case 3: sim_stat.rd_bytes++; return sim_read(sim_ofs++, sim_ctl >> 3);
+      default: return 0;
+   }
+}
+
+static void sim_bus_wr(uint32_t addr, iodata_t wb)
+{
+   switch(addr - _WIZCHIP_IO_BASE_)
+   {
+      case 0: sim_stat.hdr_bytes++; sim_ofs = (sim_ofs & 0x00FF) | (((uint16_t)wb) << 8); break;
+      case 1: sim_stat.hdr_bytes++; sim_ofs = (sim_ofs & 0xFF00) | wb;                    break;
+      case 2: sim_stat.hdr_bytes++; sim_ctl = wb;                                         break;
+      case 3: sim_stat.wr_bytes++;  sim_write(sim_ofs++, sim_ctl >> 3, wb);              break;
+      default: break;
+   }
+}
+
+static iodata_t sim_bus_readdata(uint32_t addr)
+{
+   sim_stat.calls++;
+   return sim_bus_rd(addr);
+}
+
+static void sim_bus_writedata(uint32_t addr, iodata_t wb)
+{
+   sim_stat.calls++;
+   sim_bus_wr(addr, wb);
+}
+
+static void sim_bus_readburst(uint32_t addr, iodata_t* pBuf, datasize_t len, uint8_t addrinc)
+{
+   sim_stat.calls++;
+   while(len-- > 0)
+   {
+      *pBuf++ = sim_bus_rd(addr);
+      if(addrinc) addr++;
+   }
+}
+
+static void sim_bus_writeburst(uint32_t addr, iodata_t* pBuf, datasize_t len, uint8_t addrinc)
+{
+   sim_stat.calls++;
+   while(len-- > 0)
+   {
+      sim_bus_wr(addr, *pBuf++);
+      if(addrinc) addr++;
+   }
+}
+
+/// @cond DOXY_APPLY_CODE
+#else
+   #error "Unknown _WIZCHIP_IO_MODE_ in W6100 Simulator. !!!"
+#endif
+/// @endcond
+
+void w6100_sim_init(void)
+{
+   w6100_sim_reset();
+   sim_cost.sclk_khz      = 20000;
+   sim_cost.frame_ns      = 2000;
+   sim_cost.call_ns       = 0;
+   sim_cost.bus_cycle_ns  = 100;
+   sim_cost.cr_busy_reads = 0;
+   w6100_sim_clrstat();
+
+   reg_wizchip_cris_cbfunc(sim_cris_enter, sim_cris_exit);
+   reg_wizchip_cs_cbfunc(sim_cs_select, sim_cs_deselect);
+#if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
+   reg_wizchip_spi_cbfunc(sim_spi_readbyte, sim_spi_writebyte, sim_spi_readburst, sim_spi_writeburst);
+#else
+   reg_wizchip_bus_cbfunc(sim_bus_readdata, sim_bus_writedata, sim_bus_readburst, sim_bus_writeburst);
+#endif
+}
+
+void w6100_sim_setcost(wiz_SimCost* cost)
+{
+   sim_cost = *cost;
+}
+
+void w6100_sim_getstat(wiz_SimStat* stat)
+{
+   uint64_t bytes = (uint64_t)sim_stat.hdr_bytes + sim_stat.rd_bytes + sim_stat.wr_bytes;
+   *stat = sim_stat;
+   stat->bus_ns = (uint64_t)sim_stat.frames * sim_cost.frame_ns + (uint64_t)sim_stat.calls * sim_cost.call_ns;
+#if (_WIZCHIP_IO_MODE_ & _WIZCHIP_IO_MODE_SPI_)
+   if(sim_cost.sclk_khz) stat->bus_ns += (bytes * 8 * 1000000) / sim_cost.sclk_khz;
+#else
+   stat->bus_ns += bytes * sim_cost.bus_cycle_ns;
+#endif
+}
+
+void w6100_sim_clrstat(void)
+{
+   memset(&sim_stat, 0, sizeof(sim_stat));
+}
+
+void w6100_sim_reg_txcbfunc(void (*sim_tx)(uint8_t sn, uint8_t* addr, uint8_t addrlen, uint16_t port, uint8_t* buf, datasize_t len))
+{
+   sim_txcb = sim_tx;
+}
+
+int8_t w6100_sim_accept(uint8_t sn, uint8_t* addr, uint8_t addrlen, uint16_t port)
+{
+   if(sn >= _WIZCHIP_SOCK_NUM_ || *SIM_Sn(sn,_Sn_SR_) != SOCK_LISTEN) return -1;
+   if(addrlen == 16)
+   {
+      memcpy(SIM_Sn(sn,_Sn_DIP6R_), addr, 16);
+      *SIM_Sn(sn,_Sn_ESR_) = Sn_ESR_TCPOP_SVR | Sn_ESR_TCPM_IPV6;
+   }
+   else
+   {
+      memcpy(SIM_Sn(sn,_Sn_DIPR_), addr, 4);
+      *SIM_Sn(sn,_Sn_ESR_) = Sn_ESR_TCPOP_SVR | Sn_ESR_TCPM_IPV4;
+   }
+   sim_set16(SIM_Sn(sn,_Sn_DPORTR_), port);
+   *SIM_Sn(sn,_Sn_SR_)  = SOCK_ESTABLISHED;
+   *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_CON;
+   return 0;
+}
+
+int8_t w6100_sim_peer_close(uint8_t sn)
+{
+   if(sn >= _WIZCHIP_SOCK_NUM_ || *SIM_Sn(sn,_Sn_SR_) != SOCK_ESTABLISHED) return -1;
+   *SIM_Sn(sn,_Sn_SR_)  = SOCK_CLOSE_WAIT;
+   *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_DISCON;
+   return 0;
+}
+
+int8_t w6100_sim_peer_window(uint8_t sn, int32_t win)
+{
+   uint8_t sr;
+   if(sn >= _WIZCHIP_SOCK_NUM_) return -1;
+   sr = *SIM_Sn(sn,_Sn_SR_);
+   if(sr != SOCK_ESTABLISHED && sr != SOCK_CLOSE_WAIT) return -1;
+   sim_peer_win[sn] = win;
+   if(sim_get16(SIM_Sn(sn,_Sn_TX_WR_)) != sim_get16(SIM_Sn(sn,_Sn_TX_RD_)) && !(*SIM_Sn(sn,_Sn_IR_) & Sn_IR_SENDOK))
+      sim_send(sn, Sn_CR_SEND);
+   return 0;
+}
+
+datasize_t w6100_sim_inject(uint8_t sn, uint8_t* buf, datasize_t len, uint8_t* addr, uint8_t addrlen, uint16_t port)
+{
+   uint8_t  head[2];
+   uint16_t wr, pack_len, freesize;
+   uint8_t  mr;
+
+   if(sn >= _WIZCHIP_SOCK_NUM_ || len <= 0) return -1;
+   mr = *SIM_Sn(sn,_Sn_MR_) & 0x0F;
+   wr = sim_get16(SIM_Sn(sn,_Sn_RX_WR_));
+   freesize = sim_rx_size(sn) - sim_rx_used(sn);
+
+   switch(*SIM_Sn(sn,_Sn_SR_))
+   {
+      case SOCK_ESTABLISHED:
+         if((uint16_t)len > freesize) len = (datasize_t)freesize;
+         if(len == 0) return -1;
+         sim_copy_to_ring(sn, wr, buf, (uint16_t)len);
+         wr += (uint16_t)len;
+         break;
+      case SOCK_UDP:
+      case SOCK_IPRAW4:
+      case SOCK_IPRAW6:
+      case SOCK_MACRAW:
+         if(mr == Sn_MR_MACRAW)
+         {
+            pack_len = (uint16_t)len + 2;
+            addrlen  = 0;
+         }
+         else
+         {
+            if(addr == 0 || (addrlen != 4 && addrlen != 16)) return -1;
+            pack_len = (uint16_t)len;
+         }
+         if(pack_len > 0x07FF) return -1;
+         if((uint32_t)2 + addrlen + (((mr & 0x03) == 0x02) ? 2 : 0) + len > freesize) return -1;
+         head[0] = (uint8_t)((pack_len >> 8) & 0x07);
+         if(addrlen == 16) head[0] |= PACK_IPv6;
+         head[1] = (uint8_t)pack_len;
+         sim_copy_to_ring(sn, wr, head, 2);                 wr += 2;
+         if(addrlen) { sim_copy_to_ring(sn, wr, addr, addrlen); wr += addrlen; }
+         if((mr & 0x03) == 0x02)   // Sn_MR_UDP4(0010), Sn_MR_UDP6(1010), Sn_MR_UDPD(1110)
+         {
+            head[0] = (uint8_t)(port >> 8);
+            head[1] = (uint8_t)port;
+            sim_copy_to_ring(sn, wr, head, 2);              wr += 2;
+         }
+         sim_copy_to_ring(sn, wr, buf, (uint16_t)len);      wr += (uint16_t)len;
+         break;
+      default:
+         return -1;
+   }
+   sim_set16(SIM_Sn(sn,_Sn_RX_WR_), wr);
+   *SIM_Sn(sn,_Sn_IR_) |= Sn_IR_RECV;
+   return len;
+}
+
+/// @cond DOXY_APPLY_CODE
+#endif
+/// @endcond
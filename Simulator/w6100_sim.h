@@ -0,0 +1,197 @@
+//* ****************************************************************************
+//! \file w6100_sim.h
+//! \brief W6100 Host Simulator Header File.
+//! \details It models the W6100 register file, SOCKETn TX/RX buffers, @ref _Sn_CR_ commands
+//!          and @ref _Sn_SR_ transitions behind the HOST interface callbacks of @ref _WIZCHIP_T_,
+//!          so io6Library can be run and measured on a build machine without a board.
+//! \version 1.0.0
+//! \date 2026/10/17
+//! \par  Revision history
+//!       <2026/10/17> 1st Release
+//! \author io6Library contributors
+//! \copyright
+//!
+//! Copyright (c)  2026, io6Library contributors.
+//!
+//! Permission is hereby granted, free of charge, to any person obtaining a copy
+//! of this software and associated documentation files (the "Software"), to deal
+//! in the Software without restriction, including without limitation the rights
+//! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//! copies of the Software, and to permit persons to whom the Software is
+//! furnished to do so, subject to the following conditions:
+//!
+//! The above copyright notice and this permission notice shall be included in
+//! all copies or substantial portions of the Software.
+//!
+//! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//! SOFTWARE.
+//!
+//*****************************************************************************
+
+#ifndef _W6100_SIM_H_
+#define _W6100_SIM_H_
+
+#include <stdint.h>
+#include "wizchip_conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup W6100_simulator 3. W6100 Host Simulator
+ * @brief A software W6100 for host builds.
+ * @details @ref w6100_sim_init() registers the simulator as the callback set of @ref _WIZCHIP_T_ \n
+ *          for the selected @ref _WIZCHIP_IO_MODE_. After that, every @ref WIZCHIP_READ(), @ref WIZCHIP_WRITE(), \n
+ *          @ref WIZCHIP_READ_BUF() and @ref WIZCHIP_WRITE_BUF() is decoded by the simulator like as a real chip.\n
+ *          The simulator counts every bus transaction and converts the count into bus time with @ref wiz_SimCost.\n\n
+ *          ex> measure the bus cost of one <b>send()</b> \n
+ *          <code>
+ *            w6100_sim_init(); \n
+ *            wizchip_init(0,0); \n
+ *            socket(0, Sn_MR_UDP4, 5000, 0); \n
+ *            w6100_sim_clrstat(); \n
+ *            sendto(0, buf, 64, destip, 5000, 4); \n
+ *            w6100_sim_getstat(&stat); // stat.frames, stat.bus_ns
+ *          </code>
+ */
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Bus cost model of @ref W6100_simulator
+ * @details @ref wiz_SimCost converts the counted transactions into the bus time of @ref wiz_SimStat.
+ * @sa w6100_sim_setcost(), w6100_sim_getstat()
+ */
+typedef struct wiz_SimCost_t
+{
+   uint32_t sclk_khz;        ///< SPI clock in kHz. Each transferred byte costs 8 SPI clocks.
+   uint32_t frame_ns;        ///< Fixed cost of one SPI frame such as CS setup/hold time and the driver overhead.
+   uint32_t call_ns;         ///< Fixed cost of one HOST interface callback invocation.
+   uint32_t bus_cycle_ns;    ///< Cost of one BUS access cycle in @ref _WIZCHIP_IO_MODE_BUS_.
+   uint8_t  cr_busy_reads;   ///< The count of @ref _Sn_CR_ reads returning the command before it is cleared.
+}wiz_SimCost;
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Bus statistics of @ref W6100_simulator
+ * @sa w6100_sim_getstat(), w6100_sim_clrstat()
+ */
+typedef struct wiz_SimStat_t
+{
+   uint32_t frames;          ///< SPI frames (address phase + data phase) or BUS access cycles
+   uint32_t hdr_bytes;       ///< Bytes of the address & control phase
+   uint32_t rd_bytes;        ///< Bytes of read data phase
+   uint32_t wr_bytes;        ///< Bytes of write data phase
+   uint32_t calls;           ///< HOST interface callback invocations
+   uint32_t cris;            ///< Critical section entries
+   uint32_t cmds;            ///< Executed @ref _Sn_CR_ commands
+   uint32_t cr_polls;        ///< Reads of @ref _Sn_CR_
+   uint64_t bus_ns;          ///< Estimated bus time by @ref wiz_SimCost
+}wiz_SimStat;
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Initializes the simulator and registers its callback functions.
+ * @details It resets the simulated chip, the bus statistics and the default @ref wiz_SimCost, \n
+ *          and then registers the simulator by calling @ref reg_wizchip_cris_cbfunc(), @ref reg_wizchip_cs_cbfunc() \n
+ *          and @ref reg_wizchip_spi_cbfunc() or @ref reg_wizchip_bus_cbfunc().
+ * @note The default cost is 20MHz SPI clock, 2us per frame, no callback cost and 0 busy reads of @ref _Sn_CR_.
+ */
+void w6100_sim_init(void);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Resets the simulated chip like as the hardware reset.
+ */
+void w6100_sim_reset(void);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Sets the bus cost model.
+ * @param cost : @ref wiz_SimCost
+ */
+void w6100_sim_setcost(wiz_SimCost* cost);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Gets the bus statistics counted since @ref w6100_sim_clrstat().
+ * @param stat : @ref wiz_SimStat
+ */
+void w6100_sim_getstat(wiz_SimStat* stat);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Clears the bus statistics.
+ */
+void w6100_sim_clrstat(void);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Registers a call back function for the transmitted packet.
+ * @details <i>sim_tx</i> is called when @ref Sn_CR_SEND or @ref Sn_CR_SEND6 transmits the data of SOCKETn TX buffer.\n
+ *          <i>addr</i>, <i>addrlen</i> and <i>port</i> are the destination of the datagram, or the peer of the TCP connection.
+ * @param sim_tx : callback function. If it is null, the transmitted data is dropped.
+ */
+void w6100_sim_reg_txcbfunc(void (*sim_tx)(uint8_t sn, uint8_t* addr, uint8_t addrlen, uint16_t port, uint8_t* buf, datasize_t len));
+
+/**
+ * @ingroup W6100_simulator
+ * @brief A TCP CLIENT connects to the SOCKETn in @ref SOCK_LISTEN.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param addr IP address of the client
+ * @param addrlen 4 or 16
+ * @param port port number of the client
+ * @return 0 : success \n
+ *        -1 : fail. SOCKETn is not in @ref SOCK_LISTEN.
+ */
+int8_t w6100_sim_accept(uint8_t sn, uint8_t* addr, uint8_t addrlen, uint16_t port);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief The peer closes the TCP connection of SOCKETn.
+ * @details SOCKETn is changed from @ref SOCK_ESTABLISHED to @ref SOCK_CLOSE_WAIT and @ref Sn_IR_DISCON is set.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @return 0 : success \n
+ *        -1 : fail. SOCKETn is not in @ref SOCK_ESTABLISHED.
+ */
+int8_t w6100_sim_peer_close(uint8_t sn);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Sets the receive window of the TCP peer of SOCKETn.
+ * @details @ref Sn_CR_SEND sends data as many as <i>win</i>, and the rest remains in SOCKETn TX buffer without @ref Sn_IR_SENDOK.\n
+ *          When it is called with the remained data, the data is sent as many as the new <i>win</i>.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param win The byte size the peer can receive. -1 means unlimited, that is the default.
+ * @return 0 : success \n
+ *        -1 : fail. SOCKETn is not in @ref SOCK_ESTABLISHED or @ref SOCK_CLOSE_WAIT.
+ */
+int8_t w6100_sim_peer_window(uint8_t sn, int32_t win);
+
+/**
+ * @ingroup W6100_simulator
+ * @brief Receives a packet into the SOCKETn RX buffer.
+ * @details In TCP mode, <i>buf</i> is appended to the stream and <i>addr</i>, <i>port</i> are ignored.\n
+ *          In UDP, IPRAW and MACRAW mode, <i>buf</i> is saved with the 'PACKET INFO' as a datagram.
+ *          @ref Sn_IR_RECV is set.
+ * @param sn SOCKETn. It should be <b>0 ~ @ref _WIZCHIP_SOCK_NUM_</b>.
+ * @param buf received data
+ * @param len length of <i>buf</i>
+ * @param addr source IP address
+ * @param addrlen 4 or 16
+ * @param port source port number
+ * @return The saved data length. In TCP mode, it may be smaller than <i>len</i>.\n
+ *         -1 : fail. SOCKETn can't receive or the datagram is bigger than the free size of SOCKETn RX buffer.
+ */
+datasize_t w6100_sim_inject(uint8_t sn, uint8_t* buf, datasize_t len, uint8_t* addr, uint8_t addrlen, uint16_t port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif   // _W6100_SIM_H_
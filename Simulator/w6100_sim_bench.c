@@ -0,0 +1,216 @@
+//*****************************************************************************
+//
+//! \file w6100_sim_bench.c
+//! \brief W6100 Host Simulator Bench file.
+//! \details It runs the SOCKET APIs on @ref W6100_simulator, prints the bus cost of each case
+//!          and checks the SPI frame and @ref _Sn_CR_ command counts with the expected counts.
+//!          It returns non-zero when a count drifts. Build & run it as described in README.md of this directory.
+//! \version 1.0.0
+//! \date 2026/10/17
+//! \par  Revision history
+//!       <2026/10/17> 1st Release
+//! \author io6Library contributors
+//! \copyright
+//!
+//! Copyright (c)  2026, io6Library contributors.
+//!
+//! Permission is hereby granted, free of charge, to any person obtaining a copy
+//! of this software and associated documentation files (the "Software"), to deal
+//! in the Software without restriction, including without limitation the rights
+//! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//! copies of the Software, and to permit persons to whom the Software is
+//! furnished to do so, subject to the following conditions:
+//!
+//! The above copyright notice and this permission notice shall be included in
+//! all copies or substantial portions of the Software.
+//!
+//! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//! SOFTWARE.
+//!
+//*****************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include "socket.h"
+#include "w6100_sim.h"
+
+/*
+ * The expected counts are checked only in the default configuration :
+ * _WIZCHIP_IO_MODE_SPI_VDM_ with SOCK_CMD_DEFERRED 0.
+ */
+#if (_WIZCHIP_IO_MODE_ == _WIZCHIP_IO_MODE_SPI_VDM_) && (SOCK_CMD_DEFERRED == 0)
+   #define BENCH_CHECK     1
+#else
+   #define BENCH_CHECK     0
+#endif
+
+#define BENCH_UDP_SN       0
+#define BENCH_TCP_SN       1
+#define BENCH_DGRAM_NUM    5
+#define BENCH_MMSG_NUM     6
+#define BENCH_RECV_NUM     12
+#define BENCH_RECV_SIZE    16
+#define BENCH_RECV_BATCH   64
+#define BENCH_POLL_NUM     10
+#define BENCH_IOV_SIZE     20000
+
+static uint8_t bench_mac[6] = {0x00,0x08,0xdc,0x01,0x02,0x03};
+static uint8_t bench_sip[4] = {192,168,0,10};
+static uint8_t bench_ip[4]  = {192,168,0,2};
+static uint8_t bench_buf[256];
+
+static wiz_SimStat bench_stat;
+static uint8_t     bench_drift = 0;
+
+static void bench_begin(void)
+{
+   w6100_sim_clrstat();
+}
+
+/* Print the counts of a case and check them with the expected counts */
+static void bench_end(const char* name, uint32_t per, uint32_t frames, uint32_t cmds)
+{
+   w6100_sim_getstat(&bench_stat);
+   printf("%-36s frames %5lu  cmds %3lu  bus %7lu ns", name,
+          (unsigned long)bench_stat.frames, (unsigned long)bench_stat.cmds, (unsigned long)bench_stat.bus_ns);
+   if(per > 1) printf("  (%lu frames each)", (unsigned long)(bench_stat.frames / per));
+   if(BENCH_CHECK && ((bench_stat.frames != frames) || (bench_stat.cmds != cmds)))
+   {
+      printf("  DRIFT : expected frames %lu cmds %lu", (unsigned long)frames, (unsigned long)cmds);
+      bench_drift++;
+   }
+   printf("\n");
+}
+
+static void bench_sendto(void)
+{
+   uint8_t i;
+   uint8_t dip[4];
+
+   bench_begin();
+   for(i = 0; i < BENCH_MMSG_NUM; i++)
+   {
+      memcpy(dip, bench_ip, 4);
+      dip[3] += i;
+      sendto(BENCH_UDP_SN, bench_buf, 64, dip, 7, 4);
+   }
+   bench_end("sendto, new destination", BENCH_MMSG_NUM, 67, 6);
+
+   bench_begin();
+   for(i = 0; i < BENCH_MMSG_NUM; i++) sendto(BENCH_UDP_SN, bench_buf, 64, bench_ip, 7, 4);
+   bench_end("sendto, same destination", BENCH_MMSG_NUM, 61, 6);
+}
+
+static void bench_sendmmsg(void)
+{
+   uint8_t i;
+   wiz_MMsg mm[BENCH_MMSG_NUM];
+
+   for(i = 0; i < BENCH_MMSG_NUM; i++)
+   {
+      mm[i].buf = bench_buf;
+      mm[i].len = 2;
+      memcpy(mm[i].addr, bench_ip, 4);
+      mm[i].addr[3] += (i >= 4);
+      mm[i].addrlen = 4;
+      mm[i].port = (i < 3) ? 7 : 8;
+   }
+   bench_begin();
+   sendmmsg(BENCH_UDP_SN, mm, BENCH_MMSG_NUM);
+   bench_end("sendmmsg, 6 datagrams / 3 peers", BENCH_MMSG_NUM, 39, 6);
+}
+
+static void bench_recvfrom(void)
+{
+   uint8_t i, addr[16], addrlen;
+   uint16_t port;
+   wiz_MMsg mm[8];
+
+   for(i = 0; i < BENCH_DGRAM_NUM; i++) w6100_sim_inject(BENCH_UDP_SN, (uint8_t*)"dgram0", 6, bench_ip, 4, 1000 + i);
+   bench_begin();
+   for(i = 0; i < BENCH_DGRAM_NUM; i++) recvfrom(BENCH_UDP_SN, bench_buf, sizeof(bench_buf), addr, &port, &addrlen);
+   bench_end("recvfrom, 5 datagrams", BENCH_DGRAM_NUM, 95, 5);
+
+   for(i = 0; i < BENCH_DGRAM_NUM; i++) w6100_sim_inject(BENCH_UDP_SN, (uint8_t*)"dgram0", 6, bench_ip, 4, 1000 + i);
+   bench_begin();
+   recvmmsg(BENCH_UDP_SN, bench_buf, sizeof(bench_buf), mm, 8);
+   bench_end("recvmmsg, 5 datagrams", BENCH_DGRAM_NUM, 8, 1);
+}
+
+static void bench_recv(datasize_t batch, const char* name, uint32_t frames, uint32_t cmds)
+{
+   uint8_t i;
+
+   setsockopt(BENCH_TCP_SN, SO_RECVBATCH, &batch);
+   w6100_sim_inject(BENCH_TCP_SN, bench_buf, BENCH_RECV_NUM * BENCH_RECV_SIZE, 0, 0, 0);
+   bench_begin();
+   for(i = 0; i < BENCH_RECV_NUM; i++) recv(BENCH_TCP_SN, bench_buf, BENCH_RECV_SIZE);
+   bench_end(name, BENCH_RECV_NUM, frames, cmds);
+   batch = 0;
+   setsockopt(BENCH_TCP_SN, SO_RECVBATCH, &batch);
+}
+
+static void bench_poll(void)
+{
+   uint8_t i;
+   wiz_PollFd fd = {BENCH_TCP_SN, SIK_RECEIVED | SIK_SENT, 0};
+
+   setSn_IMR(BENCH_TCP_SN, 0xFF);
+   wiz_poll(&fd, 1, 0);
+   bench_begin();
+   for(i = 0; i < BENCH_POLL_NUM; i++) wiz_poll(&fd, 1, 0);
+   bench_end("wiz_poll, idle socket", BENCH_POLL_NUM, 10, 0);
+}
+
+static void bench_sendv(void)
+{
+   static uint8_t big[BENCH_IOV_SIZE];
+   wiz_IoVec  iov[2] = {{big, BENCH_IOV_SIZE}, {big, BENCH_IOV_SIZE}};
+   datasize_t len;
+
+   bench_begin();
+   len = sendv(BENCH_TCP_SN, iov, 2);
+   bench_end("sendv, 2 x 20000B", 1, 8, 1);
+   /* The total above Sn_TxMAX is clamped to Sn_TxMAX */
+   if(len != (datasize_t)getSn_TxMAX(BENCH_TCP_SN))
+   {
+      printf("sendv returned %d, expected %d\n", len, (datasize_t)getSn_TxMAX(BENCH_TCP_SN));
+      bench_drift++;
+   }
+}
+
+int main(void)
+{
+   uint8_t lock = SYS_NET_LOCK;
+   wiz_NetInfo netinfo;
+
+   w6100_sim_init();
+   wizchip_init(0, 0);
+   wizchip_getnetinfo(&netinfo);
+   memcpy(netinfo.mac, bench_mac, 6);
+   memcpy(netinfo.ip, bench_sip, 4);
+   ctlwizchip(CW_SYS_UNLOCK, &lock);
+   wizchip_setnetinfo(&netinfo);
+
+   socket(BENCH_UDP_SN, Sn_MR_UDP4, 5000, 0);
+   bench_sendto();
+   bench_sendmmsg();
+   bench_recvfrom();
+   close(BENCH_UDP_SN);
+
+   socket(BENCH_TCP_SN, Sn_MR_TCP4, 80, 0);
+   listen(BENCH_TCP_SN);
+   w6100_sim_accept(BENCH_TCP_SN, bench_ip, 4, 4444);
+   bench_recv(0, "recv 12 x 16B", 108, 12);
+   bench_recv(BENCH_RECV_BATCH, "recv 12 x 16B, SO_RECVBATCH 64", 27, 3);
+   bench_poll();
+   bench_sendv();
+   close(BENCH_TCP_SN);
+   if(bench_drift) printf("%d case(s) drifted from the expected counts.\n", bench_drift);
+   return bench_drift ? 1 : 0;
+}